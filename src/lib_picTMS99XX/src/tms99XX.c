@@ -37,28 +37,78 @@
 
 #include <xc.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <tms99XX.h>
 
 /** SEE MY PRIVATES **/
 /*** read VDP status register ***/
 inline uint8_t readVDPstatus(struct s_tms99XX * const p_tms99XX);
+/*** read VDP status register, interrupts must already be off ***/
+inline uint8_t readVDPstatusRaw(struct s_tms99XX * const p_tms99XX);
+/*** wait for vertical blank, 0 on timeout ***/
+inline uint8_t waitVDPvblank(struct s_tms99XX * const p_tms99XX);
+/*** wait for vertical blank, no probe ***/
+inline uint8_t waitVDPvblankRaw(struct s_tms99XX * const p_tms99XX);
+/*** read the vblank timer, interrupts must already be off ***/
+inline uint16_t readVDPtimer(struct s_tms99XX * const p_tms99XX);
+/*** 1 while the blank the last stamp started is still open, interrupts must already be off ***/
+inline uint8_t checkVDPblankOpen(struct s_tms99XX * const p_tms99XX);
 /*** read VDP vram ***/
 inline int readVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t *p_data, int size, int modLen);
 /*** write VDP vram ***/
-inline int writeVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_data, int size, int modLen);
+inline int writeVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_data, int size, int modLen, uint8_t flash);
 /*** set write or read VDP vram address ***/
 inline void writeVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint16_t address, int rnw);
+/*** set write or read VDP vram address, interrupts must already be off and the bus begun ***/
+inline void writeVDPvramAddrRaw(struct s_tms99XX * const p_tms99XX, uint16_t address, int rnw);
 /*** write VDP registers ***/
 inline void writeVDPregister(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t data);
+/*** write VDP registers, interrupts must already be off ***/
+inline void writeVDPregisterRaw(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t data);
 /*** graphics mode ***/
 inline void initVDPmode(struct s_tms99XX * const p_tms99XX);
+/*** graphics II address mask bits of register 3 or 4 for a third sharing ***/
+inline uint8_t getVDPgfx2Mask(uint8_t gfx2Thirds, uint8_t regNum);
 /*** reset vdp ***/
 inline void resetVDP(struct s_tms99XX * const p_tms99XX);
-/** bit setters **/
+/** vram mirrors **/
 /*** NO NULL CHECK, USED INSIDE FUNCTIONS THAT DO THAT FIRST ***/
-inline void setCtrlBitToOne(struct s_tms99XX * const p_tms99XX, uint8_t bitNum);
-inline void setCtrlBitToZero(struct s_tms99XX * const p_tms99XX, uint8_t bitNum);
+/*** set the vdp address again if reads were served from RAM or the direction changed, interrupts must already be off ***/
+inline void syncVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint8_t rnw);
+/*** move the tracked address past a transfer ***/
+inline void advanceVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint16_t size);
+/*** find a valid mirror holding the whole range ***/
+inline struct s_tms99XX_mirror *findVDPmirror(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size);
+/*** copy written data into overlapping mirrors ***/
+inline void writeVDPmirrors(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint8_t const * const p_data, uint16_t size, uint16_t modLen);
+/** upload cache **/
+/*** NO NULL CHECK, USED INSIDE FUNCTIONS THAT DO THAT FIRST ***/
+/*** upload unless resident ***/
+inline uint8_t uploadVDPvram(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint8_t const *p_data, uint16_t size, uint8_t flash);
+/*** hash of a block ***/
+inline uint16_t hashVDPdata(uint8_t const *p_data, uint16_t size);
+/*** 1 if the table holds the block as resident ***/
+inline uint8_t findVDPupload(struct s_tms99XX_uploadCache const * const p_uploadCache, uint16_t vramAddr, uint16_t size, uint16_t hash);
+/*** forget uploads a write overlaps ***/
+inline void invalidateVDPuploads(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size);
+/** write combining **/
+/*** add a small write to the combine buffer, 0 if it has to go to the bus ***/
+inline uint8_t combineVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_data, int size);
+/*** write the combine buffer as one burst, 0 if a transfer timed out ***/
+inline uint8_t flushVDPcombine(struct s_tms99XX * const p_tms99XX);
+/** bit setters, masks can hold more than one pin ex. chip selects of a group **/
+/*** NO NULL CHECK, USED INSIDE FUNCTIONS THAT DO THAT FIRST ***/
+inline void setCtrlMaskToOne(struct s_tms99XX * const p_tms99XX, uint8_t mask);
+inline void setCtrlMaskToZero(struct s_tms99XX * const p_tms99XX, uint8_t mask);
+/** bus state, only touch TRIS and MODE when they change **/
+/*** NO NULL CHECK, USED INSIDE FUNCTIONS THAT DO THAT FIRST ***/
+inline void beginVDPbus(struct s_tms99XX * const p_tms99XX);
+inline void setVDPbusDir(struct s_tms99XX * const p_tms99XX, uint8_t busDir);
+inline void setVDPmode(struct s_tms99XX * const p_tms99XX, uint8_t level);
+
+/*** last struct to drive the bus, another struct on the same pins (group, second vdp) makes the cached state unknown. external linkage, the inline privates use it ***/
+struct s_tms99XX *gp_tms99XXbusOwner = NULL;
 
 /** INITIALIZE AND FREE MY STRUCTS **/
 
@@ -88,10 +138,19 @@ void initTMS99XXport(struct s_tms99XX * const p_tms99XX, volatile unsigned char
   
   p_tms99XX->nINT = nINT;
   
+  /**** pin masks, saves a shift loop on every strobe ****/
+  p_tms99XX->nCSRmask = (uint8_t)(1 << nCSR);
+  
+  p_tms99XX->nCSWmask = (uint8_t)(1 << nCSW);
+  
+  p_tms99XX->modeMask = (uint8_t)(1 << mode);
+  
+  p_tms99XX->nresetMask = (uint8_t)(1 << nreset);
+  
   /**** setup control ports to default state ****/
   *p_tms99XX->p_dataTRIS = 0xFF;
   
-  *p_ctrlTRIS &= (unsigned char)~((1 << nCSR) | (1 << nCSW) | (1 << mode) | (1 << nreset));
+  *p_ctrlTRIS &= (unsigned char)~(p_tms99XX->nCSRmask | p_tms99XX->nCSWmask | p_tms99XX->modeMask | p_tms99XX->nresetMask);
   
   *p_intTRIS |= (unsigned char)(1 << nINT);
 }
@@ -121,6 +180,45 @@ void initTMS99XX(struct s_tms99XX * const p_tms99XX, uint8_t vdpMode, uint8_t ba
   
   p_tms99XX->colorReg = (unsigned char)(backColor & 0x0F);
   
+  p_tms99XX->statusLatch = 0;
+  
+  /**** busy poll nINT with no timeout till setTMS99XXvblankWait says otherwise ****/
+  p_tms99XX->vblankFlag = 0;
+  
+  p_tms99XX->vblankMode = VBLANK_POLL;
+  
+  p_tms99XX->vblankTimeout = 0;
+  
+  p_tms99XX->p_vblankYield = NULL;
+  
+  /**** no timer, fixed byte count per blank till initTMS99XXvblankTimer and calibrateTMS99XXvblank ****/
+  p_tms99XX->p_timerL = NULL;
+  
+  p_tms99XX->p_timerH = NULL;
+  
+  p_tms99XX->timerTicksPerMs = 0;
+  
+  p_tms99XX->framePeriod = 0;
+  
+  p_tms99XX->blankWindow = 0;
+  
+  p_tms99XX->vblankStamp = 0;
+  
+  p_tms99XX->videoStandard = VIDEO_UNKNOWN;
+  
+  /**** no address set yet, no mirrors ****/
+  p_tms99XX->vramAddr = 0;
+  
+  p_tms99XX->vramAddrState = VRAM_ADDR_UNKNOWN;
+  
+  p_tms99XX->vramAddrRead = 0;
+  
+  p_tms99XX->p_mirrors = NULL;
+  
+  p_tms99XX->p_uploadCache = NULL;
+  
+  p_tms99XX->p_combine = NULL;
+  
   /**** set vdp addresses ****/
   p_tms99XX->nameTableAddr = NAME_TABLE_ADDR;
   
@@ -132,6 +230,8 @@ void initTMS99XX(struct s_tms99XX * const p_tms99XX, uint8_t vdpMode, uint8_t ba
   
   p_tms99XX->spritePatternAddr = SPRITE_PATTERN_TABLE_ADDR;
   
+  p_tms99XX->gfx2Thirds = GFX2_THIRDS_FULL;
+  
   /**** set VDP ports ****/
   p_tms99XX->p_dataPortW = p_dataPortW;
   
@@ -144,13 +244,16 @@ void initTMS99XX(struct s_tms99XX * const p_tms99XX, uint8_t vdpMode, uint8_t ba
   /**** set ports to output default values ****/
   *p_tms99XX->p_dataPortW = 0x00;
   
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->nreset);
+  /**** reset low, mode and chip selects high in one port write ****/
+  p_tms99XX->ctrlShadow = (uint8_t)((*p_tms99XX->p_ctrlPortW | p_tms99XX->modeMask | p_tms99XX->nCSRmask | p_tms99XX->nCSWmask) & ~p_tms99XX->nresetMask);
+  
+  *p_tms99XX->p_ctrlPortW = p_tms99XX->ctrlShadow;
   
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->mode);
+  p_tms99XX->modeLevel = 1;
   
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSR);
+  p_tms99XX->busDir = BUS_UNKNOWN;
   
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSW);
+  gp_tms99XXbusOwner = p_tms99XX;
   
   /**** reset vdp ****/
   resetVDP(p_tms99XX);
@@ -170,6 +273,146 @@ void setTMS99XXmode(struct s_tms99XX * const p_tms99XX, uint8_t vdpMode)
   initVDPmode(p_tms99XX);
 }
 
+/*** Set graphics II third sharing ***/
+void setTMS99XXgfx2Thirds(struct s_tms99XX * const p_tms99XX, uint8_t gfx2Thirds)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  p_tms99XX->gfx2Thirds = gfx2Thirds;
+  
+  if(p_tms99XX->vdpMode != GFXII_MODE) return;
+  
+  writeVDPregister(p_tms99XX, REGISTER_3, getTMS99XXgfx2Reg(p_tms99XX, REGISTER_3));
+  
+  writeVDPregister(p_tms99XX, REGISTER_4, getTMS99XXgfx2Reg(p_tms99XX, REGISTER_4));
+}
+
+/*** Get graphics II register 3 or 4 ***/
+uint8_t getTMS99XXgfx2Reg(struct s_tms99XX const * const p_tms99XX, uint8_t regNum)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  /**** the top bit picks 0x0000 or 0x2000, the rest mask the third and name bits ****/
+  switch(regNum)
+  {
+    case REGISTER_3:
+      return (uint8_t)((p_tms99XX->colorTableAddr & 0x2000 ? 0x80 : 0x00) | getVDPgfx2Mask(p_tms99XX->gfx2Thirds, REGISTER_3));
+    case REGISTER_4:
+      return (uint8_t)((p_tms99XX->patternTableAddr & 0x2000 ? 0x04 : 0x00) | getVDPgfx2Mask(p_tms99XX->gfx2Thirds, REGISTER_4));
+    default:
+      return 0;
+  }
+}
+
+/*** Get table third a screen third reads ***/
+uint8_t getTMS99XXgfx2Third(uint8_t gfx2Thirds, uint8_t table, uint8_t third)
+{
+  /**** register 3 bits 6 and 5, register 4 bits 1 and 0, mask the third number ****/
+  if(table == LAYOUT_COLOR) return (uint8_t)(third & (getVDPgfx2Mask(gfx2Thirds, REGISTER_3) >> 5));
+  
+  return (uint8_t)(third & getVDPgfx2Mask(gfx2Thirds, REGISTER_4));
+}
+
+/*** Get the register values the struct describes ***/
+void getTMS99XXshadowRegs(struct s_tms99XX const * const p_tms99XX, uint8_t * const p_registers)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  if(!p_registers) return;
+  
+  /**** same values initVDPmode writes ****/
+  p_registers[REGISTER_0] = p_tms99XX->register0;
+  
+  p_registers[REGISTER_1] = p_tms99XX->register1;
+  
+  p_registers[REGISTER_2] = (uint8_t)(p_tms99XX->nameTableAddr >> NAME_TABLE_ADDR_SCALE);
+  
+  if(p_tms99XX->vdpMode == GFXII_MODE)
+  {
+    p_registers[REGISTER_3] = getTMS99XXgfx2Reg(p_tms99XX, REGISTER_3);
+    
+    p_registers[REGISTER_4] = getTMS99XXgfx2Reg(p_tms99XX, REGISTER_4);
+  }
+  else
+  {
+    p_registers[REGISTER_3] = (uint8_t)(p_tms99XX->colorTableAddr >> COLOR_TABLE_ADDR_SCALE);
+    
+    p_registers[REGISTER_4] = (uint8_t)(p_tms99XX->patternTableAddr >> PATTERN_TABLE_ADDR_SCALE);
+  }
+  
+  p_registers[REGISTER_5] = (uint8_t)(p_tms99XX->spriteAttributeAddr >> SPRITE_ATTRIBUTE_TABLE_ADDR_SCALE);
+  
+  p_registers[REGISTER_6] = (uint8_t)(p_tms99XX->spritePatternAddr >> SPRITE_PATTERN_TABLE_ADDR_SCALE);
+  
+  p_registers[REGISTER_7] = p_tms99XX->colorReg;
+}
+
+/*** Set the struct from register values written to the VDP ***/
+void setTMS99XXshadowRegs(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_registers)
+{
+  uint8_t gfx2Thirds = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  if(!p_registers) return;
+  
+  p_tms99XX->register0 = p_registers[REGISTER_0];
+  
+  p_tms99XX->register1 = p_registers[REGISTER_1];
+  
+  /**** M3 is register 0 bit 1, M2 and M1 are register 1 bits 3 and 4, inverse of initVDPmode ****/
+  p_tms99XX->vdpMode = (uint8_t)(((p_registers[REGISTER_0] >> 1) & 0x01) | ((p_registers[REGISTER_1] >> 2) & 0x06));
+  
+  p_tms99XX->nameTableAddr = (uint16_t)((uint16_t)p_registers[REGISTER_2] << NAME_TABLE_ADDR_SCALE);
+  
+  /**** graphics II only uses the top bit for the address ****/
+  p_tms99XX->colorTableAddr = (uint16_t)((uint16_t)(p_tms99XX->vdpMode == GFXII_MODE ? (p_registers[REGISTER_3] & 0x80) : p_registers[REGISTER_3]) << COLOR_TABLE_ADDR_SCALE);
+  
+  p_tms99XX->patternTableAddr = (uint16_t)((uint16_t)(p_tms99XX->vdpMode == GFXII_MODE ? (p_registers[REGISTER_4] & 0x04) : p_registers[REGISTER_4]) << PATTERN_TABLE_ADDR_SCALE);
+  
+  p_tms99XX->spriteAttributeAddr = (uint16_t)((uint16_t)p_registers[REGISTER_5] << SPRITE_ATTRIBUTE_TABLE_ADDR_SCALE);
+  
+  p_tms99XX->spritePatternAddr = (uint16_t)((uint16_t)p_registers[REGISTER_6] << SPRITE_PATTERN_TABLE_ADDR_SCALE);
+  
+  p_tms99XX->colorReg = p_registers[REGISTER_7];
+  
+  p_tms99XX->gfx2Thirds = GFX2_THIRDS_FULL;
+  
+  if(p_tms99XX->vdpMode != GFXII_MODE) return;
+  
+  /**** find the third sharing the mask bits belong to, full if none match ****/
+  for(gfx2Thirds = GFX2_THIRDS_FULL; gfx2Thirds <= GFX2_THIRDS_HYBRID; gfx2Thirds++)
+  {
+    p_tms99XX->gfx2Thirds = gfx2Thirds;
+    
+    if((getTMS99XXgfx2Reg(p_tms99XX, REGISTER_3) == p_registers[REGISTER_3]) && (getTMS99XXgfx2Reg(p_tms99XX, REGISTER_4) == p_registers[REGISTER_4])) return;
+  }
+  
+  p_tms99XX->gfx2Thirds = GFX2_THIRDS_FULL;
+}
+
+/*** Set the struct for one register written to the VDP ***/
+void setTMS99XXshadowReg(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t regData)
+{
+  uint8_t registers[8];
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  if(regNum > REGISTER_7) return;
+  
+  /**** the other registers still hold what the struct describes, mode and table addresses depend on several ****/
+  getTMS99XXshadowRegs(p_tms99XX, registers);
+  
+  registers[regNum] = regData;
+  
+  setTMS99XXshadowRegs(p_tms99XX, registers);
+}
+
 /*** Set the TMS99XX to blank the current sprite and pattern planes. ***/
 void setTMS99XXblank(struct s_tms99XX * const p_tms99XX, uint8_t mode)
 {
@@ -271,6 +514,23 @@ void setTMS99XXreg(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t r
   writeVDPregister(p_tms99XX, regNum, regData);
 }
 
+/*** Set a register from an interrupt routine ***/
+void isrTMS99XXreg(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t regData)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  /**** already in an interrupt, no di/ei. transfers set the address and move bytes in one di section, so this lands before or after one ****/
+  PROBE_ISR_ENTER();
+  
+  writeVDPregisterRaw(p_tms99XX, regNum, regData);
+  
+  PROBE_ISR_EXIT();
+  
+  /**** the tracked address is still right, the vdp one is not. the next transfer sets it again ****/
+  if(p_tms99XX->vramAddrState == VRAM_ADDR_SYNC) p_tms99XX->vramAddrState = VRAM_ADDR_LAG;
+}
+
 /*** Write a struct/union table to vram using address. Alighned to data size. ***/
 int setTMS99XXvramTableData(struct s_tms99XX * const p_tms99XX, uint16_t tableAddr, void const * const p_data, int startNum, int number, int size)
 {
@@ -279,7 +539,7 @@ int setTMS99XXvramTableData(struct s_tms99XX * const p_tms99XX, uint16_t tableAd
   /**** set starting vram address to write too ****/
   writeVDPvramAddr(p_tms99XX, tableAddr + (uint16_t)(size * startNum), 0); 
   
-  return writeVDPvram(p_tms99XX, (uint8_t *)p_data, size * number, size * number);
+  return writeVDPvram(p_tms99XX, (uint8_t const *)p_data, size * number, size * number, 0);
 }
 
 /*** Set the start of the write VRAM address. After this is set writes will auto increment the address. ***/
@@ -297,13 +557,58 @@ void setTMS99XXvramReadAddr(struct s_tms99XX * const p_tms99XX, uint16_t vramAdd
 /*** Write array of byte data to VRAM. ***/
 int setTMS99XXvramData(struct s_tms99XX * const p_tms99XX, void const * const p_data, int size)
 {
-  return writeVDPvram(p_tms99XX, (uint8_t *)p_data, size, size);
+  if(combineVDPvram(p_tms99XX, (uint8_t const *)p_data, size)) return size;
+  
+  return writeVDPvram(p_tms99XX, (uint8_t const *)p_data, size, size, 0);
+}
+
+/*** Write array of byte data from program memory to VRAM. ***/
+int setTMS99XXvramFlashData(struct s_tms99XX * const p_tms99XX, void const * const p_data, int size)
+{
+  if(combineVDPvram(p_tms99XX, (uint8_t const *)p_data, size)) return size;
+  
+  return writeVDPvram(p_tms99XX, (uint8_t const *)p_data, size, size, 1);
 }
 
 /*** constant value to VRAM. ***/
 int setTMS99XXvramConstData(struct s_tms99XX * const p_tms99XX, uint8_t const data, int size)
 {
-  return writeVDPvram(p_tms99XX, &data, size, 1);
+  return writeVDPvram(p_tms99XX, &data, size, 1, 0);
+}
+
+/*** write all of a block or fail ***/
+uint8_t setTMS99XXvramBlock(struct s_tms99XX * const p_tms99XX, void const * const p_data, uint16_t size, uint8_t source)
+{
+  int amtWrote = 0;
+  uint8_t const *p_src = (uint8_t const *)p_data;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_src) return 0;
+  
+  /**** paced transfers can take less than asked, 0 is only a timed out wait ****/
+  for(; size > 0; size -= (uint16_t)amtWrote)
+  {
+    switch(source)
+    {
+      case VRAM_SRC_FLASH:
+        amtWrote = setTMS99XXvramFlashData(p_tms99XX, p_src, (int)size);
+        break;
+      case VRAM_SRC_CONST:
+        amtWrote = setTMS99XXvramConstData(p_tms99XX, *p_src, (int)size);
+        break;
+      default:
+        amtWrote = setTMS99XXvramData(p_tms99XX, p_src, (int)size);
+        break;
+    }
+    
+    if(!amtWrote) return 0;
+    
+    if(source != VRAM_SRC_CONST) p_src += amtWrote;
+  }
+  
+  return 1;
 }
 
 /*** set sprite to a terminator value ***/
@@ -326,235 +631,1029 @@ void setTMS99XXvramSpriteTerm(struct s_tms99XX * const p_tms99XX, uint8_t const
   
   spriteTerm.dataNibbles.colorCode = TMS_TRANSPARENT;
   
-  writeVDPvramAddr(p_tms99XX, p_tms99XX->spriteAttributeAddr + (num * sizeof(spriteTerm)), 1);
+  writeVDPvramAddr(p_tms99XX, p_tms99XX->spriteAttributeAddr + (num * sizeof(spriteTerm)), 0);
   
   /**** no need to check return, plenty of time to write 4 bytes ****/
-  writeVDPvram(p_tms99XX, (uint8_t const * const)&spriteTerm, sizeof(spriteTerm), sizeof(spriteTerm));
+  writeVDPvram(p_tms99XX, (uint8_t const * const)&spriteTerm, sizeof(spriteTerm), sizeof(spriteTerm), 0);
 }
 
 /*** Read array of byte data to VRAM. ***/
 int getTMS99XXvramData(struct s_tms99XX * const p_tms99XX, void *p_data, int size)
 {
-  return readVDPvram(p_tms99XX, (uint8_t *)p_data, size, size);
-}
-
-/*** Read status register of VDP. ***/
-uint8_t getTMS99XXstatus(struct s_tms99XX * const p_tms99XX)
-{
-  return readVDPstatus(p_tms99XX);
-}
-
-/*** clear data from VRAM. ***/
-void clearTMS99XXvramData(struct s_tms99XX * const p_tms99XX)
-{
-  int      index = 0;
-  uint8_t  data = 0x00;
-  uint16_t amtWrote = 0;
+  struct s_tms99XX_mirror *p_mirror = NULL;
   
-  /**** set start address to write 0x00 to all of the VRAM ****/
-  writeVDPvramAddr(p_tms99XX, 0x0000, 0);
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
   
-  for(index = 0; index < MEM_SIZE; index += amtWrote)
-  {
-    amtWrote = (uint16_t)writeVDPvram(p_tms99XX, &data, MEM_SIZE - index, 1);
-  }
+  if(!p_data) return 0;
+  
+  if(size <= 0) return 0;
+  
+  /**** combined bytes may be in the range ****/
+  if(!flushVDPcombine(p_tms99XX)) return 0;
+  
+  p_mirror = findVDPmirror(p_tms99XX, p_tms99XX->vramAddr, (uint16_t)size);
+  
+  if(!p_mirror) return readVDPvram(p_tms99XX, (uint8_t *)p_data, size, size);
+  
+  /**** served from RAM, the vdp address now lags behind ****/
+  memcpy(p_data, &p_mirror->p_buffer[p_tms99XX->vramAddr - p_mirror->vramAddr], (size_t)size);
+  
+  p_mirror->bytesLocal += (uint32_t)size;
+  
+  advanceVDPvramAddr(p_tms99XX, (uint16_t)size);
+  
+  p_tms99XX->vramAddrState = VRAM_ADDR_LAG;
+  
+  return size;
 }
 
-/*** check vram with read write check ***/
-uint8_t checkTMS99XXvram(struct s_tms99XX * const p_tms99XX)
+/*** read all of a block or fail ***/
+uint8_t getTMS99XXvramBlock(struct s_tms99XX * const p_tms99XX, void *p_data, uint16_t size)
 {
-  /**** future improvemtn, crc check of some sort ****/
-  int      index = 0;
-  uint16_t bufIndex = 0;
-  uint8_t  buffer[256] = {0};
-  uint8_t  data = 0x55;
-  uint16_t amtRead = 0;
-  uint16_t amtWrote = 0;
-  
-  /**** set start address to write 0x55 to all of the VRAM ****/
-  writeVDPvramAddr(p_tms99XX, 0x0000, 0);
+  int amtRead = 0;
+  uint8_t *p_dest = (uint8_t *)p_data;
   
-  for(index = 0; index < MEM_SIZE; index += amtWrote)
-  {
-    amtWrote = (uint16_t)writeVDPvram(p_tms99XX, &data, MEM_SIZE - index, 1);
-  }
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
   
-  /**** reset address to 0 for read ****/
-  writeVDPvramAddr(p_tms99XX, 0x0000, 1);
+  if(!p_dest) return 0;
   
-  /**** loop in chunks of 256 to read vram ****/
-  for(index = 0; index < MEM_SIZE; index += amtRead)
+  for(; size > 0; size -= (uint16_t)amtRead)
   {
+    amtRead = getTMS99XXvramData(p_tms99XX, p_dest, (int)size);
     
-    /**** read 256 chunk ****/
-    amtRead = (uint16_t)readVDPvram(p_tms99XX, buffer, sizeof(buffer), sizeof(buffer));
+    if(!amtRead) return 0;
     
-    /**** check all chunks against original, return 0 if it fails ****/
-    for(bufIndex = 0; bufIndex < amtRead; bufIndex++)
-    {
-      if(buffer[bufIndex] != data) return 0;
-    }
+    p_dest += amtRead;
   }
   
-  /**** return 1 on success ****/
   return 1;
 }
 
-/** SEE MY PRIVATES **/
-/*** read VDP status register ***/
-inline uint8_t readVDPstatus(struct s_tms99XX * const p_tms99XX)
+/*** Read data from VRAM over the bus, never from a mirror ***/
+int getTMS99XXvramBusData(struct s_tms99XX * const p_tms99XX, void *p_data, int size)
 {
-  uint8_t tempData;
-  
   /**** NULL Check ****/
   if(!p_tms99XX) return 0;
- 
-  di();
   
-  /**** no need to set mode to 1 for register mode ****/
+  if(!p_data) return 0;
   
-  /**** no need to set data bus to input mode ****/
+  if(size <= 0) return 0;
   
-  /**** set active low chip select read to 0 ****/
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->nCSR);
+  /**** combined bytes may be in the range ****/
+  if(!flushVDPcombine(p_tms99XX)) return 0;
   
-  /**** read data ****/
-  tempData = *p_tms99XX->p_dataPortR;
+  return readVDPvram(p_tms99XX, (uint8_t *)p_data, size, size);
+}
+
+/*** mirror a vram region in RAM ***/
+void addTMS99XXvramMirror(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_mirror * const p_mirror, uint16_t vramAddr, uint8_t *p_buffer, uint16_t size)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
   
-  /**** set active low chip select read back to 1 ****/
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSR);
+  if(!p_mirror) return;
   
-  ei();
+  if(!p_buffer) return;
   
-  return tempData;
+  p_mirror->p_buffer = p_buffer;
+  
+  p_mirror->vramAddr = vramAddr & VRAM_ADDR_MASK;
+  
+  p_mirror->size = size;
+  
+  p_mirror->valid = 0;
   
+  p_mirror->bytesLocal = 0;
+  
+  p_mirror->bytesWrote = 0;
+  
+  p_mirror->p_next = p_tms99XX->p_mirrors;
+  
+  p_tms99XX->p_mirrors = p_mirror;
 }
 
-/*** read VDP vram ***/
-inline int readVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t *p_data, int size, int modLen)
+/*** stop mirroring a region ***/
+void removeTMS99XXvramMirror(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_mirror * const p_mirror)
 {
-  int index = 0;
+  struct s_tms99XX_mirror **pp_link = NULL;
   
   /**** NULL Check ****/
-  if(!p_tms99XX) return 0;
- 
-  if(!p_data) return 0;
-  
-  di();
-  
-  /**** set mode to 0 ****/
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->mode);
-  
-  /**** no need to set data bus to input mode ****/
+  if(!p_tms99XX) return;
   
-  /**** pole for interrupt ****/
-  /**** only pole if IRQ bit set and screen is not blank ****/
-  /**** for 4.3 miliseconds there is no access window waiting, total time is then 4 us ****/
-  /***** approx 1000 bytes can be handled ****/
-  if(((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && ((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01))
-  {
-    /**** nINT is a negative interrupt, while loop will exit on 0 ****/
-    while(((*p_tms99XX->p_intPortR) >> p_tms99XX->nINT) & 0x01);
-  }
+  if(!p_mirror) return;
   
-  for(index = 0; index < size; index++)
+  for(pp_link = &p_tms99XX->p_mirrors; *pp_link; pp_link = &(*pp_link)->p_next)
   {
+    if(*pp_link != p_mirror) continue;
     
-    /**** set active low chip select read to 0 ****/
-    setCtrlBitToZero(p_tms99XX, p_tms99XX->nCSR);
-    
-    /**** read data from port into array ****/
-    p_data[index % modLen] = *p_tms99XX->p_dataPortR;
-    
-    /**** set active low chip select read to 1 ****/
-    setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSR);
+    *pp_link = p_mirror->p_next;
     
-    /**** use worst case delay if IRQ is not set and we are not blanking the screen ****/
-    if(!((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && !((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01))
-    {
-      __delay_us(8);
-    }
+    p_mirror->p_next = NULL;
     
-    /**** if irq is enabled, and blank is disabled, and index is 1000 or ever, return index since blank has run out ****/
-    if(((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && ((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01) && (index >= 1000))
-    {
-      break;
-    }
+    return;
   }
-  
-  /**** set mode to 1 ****/
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->mode);
-  
-  /**** status read clears the interrupt, also screws up access if done before data transfer  ****/
-  readVDPstatus(p_tms99XX);
-  
-  ei();
-  
-  return index;
 }
 
-/*** write VDP vram ***/
-inline int writeVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_data, int size, int modLen)
+/*** fill a mirror from vram ***/
+uint8_t loadTMS99XXvramMirror(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_mirror * const p_mirror)
 {
   int index = 0;
+  int amtRead = 0;
   
   /**** NULL Check ****/
   if(!p_tms99XX) return 0;
   
-  if(!p_data) return 0;
-  
-  di();
+  if(!p_mirror) return 0;
   
-  /**** set mode to 0 ****/
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->mode);
+  p_mirror->valid = 0;
   
-  /**** set data bus to output ****/
-  *p_tms99XX->p_dataTRIS = 0x00;
+  writeVDPvramAddr(p_tms99XX, p_mirror->vramAddr, 1);
   
-  /**** pole for interrupt ****/
-  /**** only pole if IRQ bit set and screen is not blank ****/
-  /**** for 4.3 miliseconds there is no access window waiting, total time is then 4 us ****/
-  /***** approx 1000 bytes can be handled ****/
-  if(((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && ((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01))
+  for(index = 0; index < (int)p_mirror->size; index += amtRead)
   {
-    /**** nINT is a negative interrupt, while loop will exit on 0 ****/
-    while(((*p_tms99XX->p_intPortR) >> p_tms99XX->nINT) & 0x01);
+    amtRead = readVDPvram(p_tms99XX, &p_mirror->p_buffer[index], (int)p_mirror->size - index, (int)p_mirror->size - index);
+    
+    if(!amtRead) return 0;
   }
   
-  for(index = 0; index < size; index++)
-  {
+  p_mirror->valid = 1;
+  
+  return 1;
+}
+
+/*** mark every mirror invalid ***/
+void invalidateTMS99XXvramMirrors(struct s_tms99XX * const p_tms99XX)
+{
+  struct s_tms99XX_mirror *p_mirror = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  for(p_mirror = p_tms99XX->p_mirrors; p_mirror; p_mirror = p_mirror->p_next)
+  {
+    p_mirror->valid = 0;
+  }
+}
+
+/*** forget what is cached over a range written through another struct ***/
+void invalidateTMS99XXvramRange(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size)
+{
+  struct s_tms99XX_mirror *p_mirror = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  if(!size) return;
+  
+  for(p_mirror = p_tms99XX->p_mirrors; p_mirror; p_mirror = p_mirror->p_next)
+  {
+    /**** 14 bit address plus 16K size fits 16 bits ****/
+    if((vramAddr < (uint16_t)(p_mirror->vramAddr + p_mirror->size)) && (p_mirror->vramAddr < (uint16_t)(vramAddr + size))) p_mirror->valid = 0;
+  }
+  
+  invalidateVDPuploads(p_tms99XX, vramAddr, size);
+  
+  /**** the other struct moved the vdp address, the next transfer sets it again ****/
+  if(p_tms99XX->vramAddrState == VRAM_ADDR_SYNC) p_tms99XX->vramAddrState = VRAM_ADDR_LAG;
+}
+
+/*** bytes served from RAM ***/
+uint32_t getTMS99XXmirrorBytesLocal(struct s_tms99XX * const p_tms99XX)
+{
+  uint32_t total = 0;
+  
+  struct s_tms99XX_mirror *p_mirror = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  for(p_mirror = p_tms99XX->p_mirrors; p_mirror; p_mirror = p_mirror->p_next)
+  {
+    total += p_mirror->bytesLocal;
+  }
+  
+  return total;
+}
+
+/*** clear mirror statistics ***/
+void clearTMS99XXmirrorStats(struct s_tms99XX * const p_tms99XX)
+{
+  struct s_tms99XX_mirror *p_mirror = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  for(p_mirror = p_tms99XX->p_mirrors; p_mirror; p_mirror = p_mirror->p_next)
+  {
+    p_mirror->bytesLocal = 0;
+    
+    p_mirror->bytesWrote = 0;
+  }
+}
+
+/*** Attach upload cache ***/
+void setTMS99XXuploadCache(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_uploadCache * const p_uploadCache)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  p_tms99XX->p_uploadCache = p_uploadCache;
+  
+  if(!p_uploadCache) return;
+  
+  p_uploadCache->hits = 0;
+  
+  p_uploadCache->misses = 0;
+  
+  invalidateTMS99XXuploadCache(p_tms99XX);
+}
+
+/*** Upload unless resident ***/
+uint8_t uploadTMS99XXvram(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, void const * const p_data, uint16_t size)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_data) return 0;
+  
+  return uploadVDPvram(p_tms99XX, vramAddr, (uint8_t const *)p_data, size, 0);
+}
+
+/*** Upload from program memory unless resident ***/
+uint8_t uploadTMS99XXvramFlash(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, void const * const p_data, uint16_t size)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_data) return 0;
+  
+  return uploadVDPvram(p_tms99XX, vramAddr, (uint8_t const *)p_data, size, 1);
+}
+
+/*** Forget all uploads ***/
+void invalidateTMS99XXuploadCache(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t index = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  if(!p_tms99XX->p_uploadCache) return;
+  
+  for(index = 0; index < UPLOAD_CACHE_ENTRIES; index++)
+  {
+    p_tms99XX->p_uploadCache->uploads[index].size = 0;
+  }
+  
+  p_tms99XX->p_uploadCache->next = 0;
+}
+
+/*** resident check without a transfer ***/
+uint8_t checkTMS99XXuploadResident(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size, uint16_t hash)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_tms99XX->p_uploadCache) return 0;
+  
+  if(!size) return 0;
+  
+  /**** a combined write could still land over it ****/
+  if(!flushVDPcombine(p_tms99XX)) return 0;
+  
+  return findVDPupload(p_tms99XX->p_uploadCache, vramAddr & VRAM_ADDR_MASK, size, hash);
+}
+
+/*** hash the upload cache keeps ***/
+uint16_t hashTMS99XXdata(void const * const p_data, uint16_t size)
+{
+  /**** NULL Check ****/
+  if(!p_data) return 0;
+  
+  return hashVDPdata((uint8_t const *)p_data, size);
+}
+
+/*** attach a write combine buffer ***/
+uint8_t setTMS99XXcombine(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_combine * const p_combine)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  /**** bytes in the old buffer go out first, it stays attached till they do ****/
+  if(!flushVDPcombine(p_tms99XX)) return 0;
+  
+  p_tms99XX->p_combine = p_combine;
+  
+  if(!p_combine) return 1;
+  
+  p_combine->count = 0;
+  
+  p_combine->writes = 0;
+  
+  p_combine->bursts = 0;
+  
+  return 1;
+}
+
+/*** write combined bytes now ***/
+uint8_t flushTMS99XXcombine(struct s_tms99XX * const p_tms99XX)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  return flushVDPcombine(p_tms99XX);
+}
+
+/*** Read status register of VDP. ***/
+uint8_t getTMS99XXstatus(struct s_tms99XX * const p_tms99XX)
+{
+  return readVDPstatus(p_tms99XX);
+}
+
+/*** Get latched status bits and clear them. ***/
+uint8_t getTMS99XXstatusLatch(struct s_tms99XX * const p_tms99XX)
+{
+  return getTMS99XXstatusLatchMask(p_tms99XX, 0xFF);
+}
+
+/*** Get some latched status bits and clear only those. ***/
+uint8_t getTMS99XXstatusLatchMask(struct s_tms99XX * const p_tms99XX, uint8_t mask)
+{
+  uint8_t tempData;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  di();
+  
+  tempData = (uint8_t)(p_tms99XX->statusLatch & mask);
+  
+  p_tms99XX->statusLatch &= (uint8_t)~mask;
+  
+  ei();
+  
+  return tempData;
+}
+
+/*** wait for vertical blank ***/
+uint8_t waitTMS99XXvblank(struct s_tms99XX * const p_tms99XX)
+{
+  uint16_t ticks = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if((p_tms99XX->register1 >> IRQ_BIT) & 0x01)
+  {
+    return waitVDPvblank(p_tms99XX);
+  }
+  
+  /**** no nINT without IRQ, the status flag still sets every frame ****/
+  while(!((readVDPstatus(p_tms99XX) >> STATUS_INT_BIT) & 0x01))
+  {
+    if(p_tms99XX->p_vblankYield) p_tms99XX->p_vblankYield();
+    
+    if(!p_tms99XX->vblankTimeout) continue;
+    
+    __delay_us(VBLANK_TICK_US);
+    
+    if(++ticks >= p_tms99XX->vblankTimeout) return 0;
+  }
+  
+  return 1;
+}
+
+/*** set how vertical blank is waited for ***/
+void setTMS99XXvblankWait(struct s_tms99XX * const p_tms99XX, uint8_t mode, uint16_t timeout, void (*p_yield)(void))
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  di();
+  
+  p_tms99XX->vblankMode = mode;
+  
+  p_tms99XX->vblankTimeout = timeout;
+  
+  p_tms99XX->p_vblankYield = p_yield;
+  
+  p_tms99XX->vblankFlag = 0;
+  
+  ei();
+}
+
+/*** nINT interrupt handler ***/
+void isrTMS99XXvblank(struct s_tms99XX * const p_tms99XX)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  /**** start of the blank, transfers measure their deadline from here ****/
+  if(p_tms99XX->p_timerL) p_tms99XX->vblankStamp = readVDPtimer(p_tms99XX);
+  
+  /**** already in an interrupt, no di/ei. status read releases nINT ****/
+  readVDPstatusRaw(p_tms99XX);
+  
+  p_tms99XX->vblankFlag = 1;
+}
+
+/*** set the timer used for vblank deadlines ***/
+uint8_t initTMS99XXvblankTimer(struct s_tms99XX * const p_tms99XX, volatile unsigned char *p_timerL, volatile unsigned char *p_timerH, uint16_t ticksPerMs)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_timerL) return 0;
+  
+  if(!p_timerH) return 0;
+  
+  /**** a 20 ms 50 Hz frame has to fit the 16 bit timer ****/
+  if(((uint32_t)ticksPerMs * 20) > 0xFFFF) return 0;
+  
+  p_tms99XX->p_timerL = p_timerL;
+  
+  p_tms99XX->p_timerH = p_timerH;
+  
+  p_tms99XX->timerTicksPerMs = ticksPerMs;
+  
+  /**** old numbers are from another timer ****/
+  p_tms99XX->framePeriod = 0;
+  
+  p_tms99XX->blankWindow = 0;
+  
+  p_tms99XX->videoStandard = VIDEO_UNKNOWN;
+  
+  return 1;
+}
+
+/*** measure frame period and blank window ***/
+uint8_t calibrateTMS99XXvblank(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t  index = 0;
+  uint16_t lines = 0;
+  uint16_t now = 0;
+  uint16_t last = 0;
+  uint16_t stamp[2] = {0};
+  uint32_t elapsed = 0;
+  uint32_t limit = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return VIDEO_UNKNOWN;
+  
+  if(!p_tms99XX->p_timerL) return VIDEO_UNKNOWN;
+  
+  limit = (uint32_t)p_tms99XX->timerTicksPerMs * VBLANK_CAL_MS;
+  
+  readVDPstatus(p_tms99XX);
+  
+  p_tms99XX->vblankFlag = 0;
+  
+  /**** timer reads off interrupts, the handler's read would change the latched high byte ****/
+  di();
+  
+  last = readVDPtimer(p_tms99XX);
+  
+  ei();
+  
+  /**** first frame is the edge to start from, a half frame may have passed before it ****/
+  for(index = 0; index < 3; index++)
+  {
+    for(;;)
+    {
+      /**** event modes, isrTMS99XXvblank stamps the frame at the edge ****/
+      if(p_tms99XX->vblankMode != VBLANK_POLL)
+      {
+        if(p_tms99XX->vblankFlag) break;
+      }
+      /**** no handler, poll the status frame flag. interrupts are only off for each read ****/
+      else if((readVDPstatus(p_tms99XX) >> STATUS_INT_BIT) & 0x01)
+      {
+        di();
+        
+        p_tms99XX->vblankStamp = readVDPtimer(p_tms99XX);
+        
+        ei();
+        
+        break;
+      }
+      
+      di();
+      
+      now = readVDPtimer(p_tms99XX);
+      
+      ei();
+      
+      elapsed += (uint16_t)(now - last);
+      
+      last = now;
+      
+      /**** no vdp, or no frames ****/
+      if(elapsed >= limit) return VIDEO_UNKNOWN;
+    }
+    
+    di();
+    
+    if(index) stamp[index - 1] = p_tms99XX->vblankStamp;
+    
+    p_tms99XX->vblankFlag = 0;
+    
+    ei();
+  }
+  
+  p_tms99XX->framePeriod = (uint16_t)(stamp[1] - stamp[0]);
+  
+  /**** 60 Hz is 16.7 ms, 50 Hz is 20 ms, split at 18.3 ms ****/
+  if((uint32_t)p_tms99XX->framePeriod * 10 < (uint32_t)p_tms99XX->timerTicksPerMs * 183)
+  {
+    p_tms99XX->videoStandard = VIDEO_NTSC;
+    
+    lines = NTSC_LINES;
+  }
+  else
+  {
+    p_tms99XX->videoStandard = VIDEO_PAL;
+    
+    lines = PAL_LINES;
+  }
+  
+  /**** the blank is every line outside the active display, less a margin for the last byte and the loop ****/
+  p_tms99XX->blankWindow = (uint16_t)(((uint32_t)p_tms99XX->framePeriod * (lines - SCREEN_LINES - VBLANK_MARGIN_LINES)) / lines);
+  
+  p_tms99XX->vblankFlag = 0;
+  
+  return p_tms99XX->videoStandard;
+}
+
+/*** clear data from VRAM. ***/
+uint8_t clearTMS99XXvramData(struct s_tms99XX * const p_tms99XX)
+{
+  int      index = 0;
+  uint8_t  data = 0x00;
+  uint16_t amtWrote = 0;
+  
+  /**** set start address to write 0x00 to all of the VRAM ****/
+  writeVDPvramAddr(p_tms99XX, 0x0000, 0);
+  
+  for(index = 0; index < MEM_SIZE; index += amtWrote)
+  {
+    amtWrote = (uint16_t)writeVDPvram(p_tms99XX, &data, MEM_SIZE - index, 1, 0);
+    
+    /**** vblank wait timed out ****/
+    if(!amtWrote) return 0;
+  }
+  
+  return 1;
+}
+
+/*** check vram with read write check ***/
+uint8_t checkTMS99XXvram(struct s_tms99XX * const p_tms99XX)
+{
+  /**** future improvemtn, crc check of some sort ****/
+  int      index = 0;
+  uint16_t bufIndex = 0;
+  uint8_t  buffer[256] = {0};
+  uint8_t  data = 0x55;
+  uint16_t amtRead = 0;
+  uint16_t amtWrote = 0;
+  
+  /**** set start address to write 0x55 to all of the VRAM ****/
+  writeVDPvramAddr(p_tms99XX, 0x0000, 0);
+  
+  for(index = 0; index < MEM_SIZE; index += amtWrote)
+  {
+    amtWrote = (uint16_t)writeVDPvram(p_tms99XX, &data, MEM_SIZE - index, 1, 0);
+    
+    /**** vblank wait timed out ****/
+    if(!amtWrote) return 0;
+  }
+  
+  /**** reset address to 0 for read ****/
+  writeVDPvramAddr(p_tms99XX, 0x0000, 1);
+  
+  /**** loop in chunks of 256 to read vram ****/
+  for(index = 0; index < MEM_SIZE; index += amtRead)
+  {
+    
+    /**** read 256 chunk ****/
+    amtRead = (uint16_t)readVDPvram(p_tms99XX, buffer, sizeof(buffer), sizeof(buffer));
+    
+    /**** vblank wait timed out ****/
+    if(!amtRead) return 0;
+    
+    /**** check all chunks against original, return 0 if it fails ****/
+    for(bufIndex = 0; bufIndex < amtRead; bufIndex++)
+    {
+      if(buffer[bufIndex] != data) return 0;
+    }
+  }
+  
+  /**** return 1 on success ****/
+  return 1;
+}
+
+/** SEE MY PRIVATES **/
+/*** read VDP status register ***/
+inline uint8_t readVDPstatus(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t tempData;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+ 
+  di();
+  
+  tempData = readVDPstatusRaw(p_tms99XX);
+  
+  ei();
+  
+  return tempData;
+  
+}
+
+/*** read VDP status register, no di/ei so it is safe in an interrupt ***/
+inline uint8_t readVDPstatusRaw(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t tempData;
+  
+  beginVDPbus(p_tms99XX);
+  
+  /**** register mode, a transfer or register write may have left mode low or the bus driven ****/
+  setVDPmode(p_tms99XX, 1);
+  
+  setVDPbusDir(p_tms99XX, BUS_INPUT);
+  
+  /**** set active low chip select read to 0 ****/
+  setCtrlMaskToZero(p_tms99XX, p_tms99XX->nCSRmask);
+  
+  /**** read data ****/
+  tempData = *p_tms99XX->p_dataPortR;
+  
+  /**** set active low chip select read back to 1 ****/
+  setCtrlMaskToOne(p_tms99XX, p_tms99XX->nCSRmask);
+  
+  /**** flags clear on read, keep them, fifth sprite number is always the latest ****/
+  p_tms99XX->statusLatch = (uint8_t)(((p_tms99XX->statusLatch | tempData) & ~STATUS_5S_NUM_MASK) | (tempData & STATUS_5S_NUM_MASK));
+  
+  return tempData;
+}
+
+/*** wait for vertical blank, probed as one phase ***/
+inline uint8_t waitVDPvblank(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t open = 0;
+  
+  PROBE_ENTER(PROBE_ID_VBLANK);
+  
+  open = waitVDPvblankRaw(p_tms99XX);
+  
+  PROBE_EXIT();
+  
+  return open;
+}
+
+/*** wait for vertical blank on nINT ***/
+inline uint8_t waitVDPvblankRaw(struct s_tms99XX * const p_tms99XX)
+{
+  uint16_t ticks = 0;
+  uint16_t now = 0;
+  uint16_t last = 0;
+  uint8_t  seenHigh = 0;
+  uint8_t  idle = 0;
+  uint8_t  open = 0;
+  uint32_t timeoutUs = 0;
+  uint32_t elapsed = 0;
+  uint32_t deadline = 0;
+  
+  /**** idle wakes on any interrupt, a count of wakes is no time. with a timeout it needs the timer, without one it waits like VBLANK_EVENT ****/
+  idle = (uint8_t)((p_tms99XX->vblankMode == VBLANK_IDLE) && (!p_tms99XX->vblankTimeout || p_tms99XX->p_timerL));
+  
+  if(idle && p_tms99XX->vblankTimeout)
+  {
+    timeoutUs = (uint32_t)p_tms99XX->vblankTimeout * VBLANK_TICK_US;
+    
+    deadline = (timeoutUs / 1000) * p_tms99XX->timerTicksPerMs + ((timeoutUs % 1000) * p_tms99XX->timerTicksPerMs) / 1000;
+    
+    /**** timer reads off interrupts, isrTMS99XXvblank's read would change the latched high byte ****/
+    di();
+    
+    last = readVDPtimer(p_tms99XX);
+    
+    ei();
+  }
+  
+  for(;;)
+  {
+    /**** event modes, the nINT interrupt handler sets the flag and stamp ****/
+    if(p_tms99XX->vblankMode != VBLANK_POLL)
+    {
+      if(p_tms99XX->vblankFlag)
+      {
+        di();
+        
+        open = checkVDPblankOpen(p_tms99XX);
+        
+        ei();
+        
+        if(open) return 1;
+        
+        /**** the blank this flag was for is over, wait for the next ****/
+        p_tms99XX->vblankFlag = 0;
+      }
+    }
+    /**** nINT is a negative interrupt, exit on 0 ****/
+    else if(!(((*p_tms99XX->p_intPortR) >> p_tms99XX->nINT) & 0x01))
+    {
+      /**** no timer, go like before ****/
+      if(!p_tms99XX->blankWindow) return 1;
+      
+      /**** saw the edge, the blank starts now ****/
+      if(seenHigh)
+      {
+        di();
+        
+        p_tms99XX->vblankStamp = readVDPtimer(p_tms99XX);
+        
+        p_tms99XX->vblankFlag = 1;
+        
+        ei();
+        
+        return 1;
+      }
+      
+      /**** low from an earlier wait that stamped it, ex. waitTMS99XXvblank then a transfer ****/
+      if(p_tms99XX->vblankFlag)
+      {
+        di();
+        
+        open = checkVDPblankOpen(p_tms99XX);
+        
+        ei();
+        
+        if(open) return 1;
+      }
+      
+      /**** low since some unknown time, release nINT and wait for a clean edge ****/
+      p_tms99XX->vblankFlag = 0;
+      
+      readVDPstatus(p_tms99XX);
+    }
+    else
+    {
+      seenHigh = 1;
+    }
+    
+    if(p_tms99XX->p_vblankYield) p_tms99XX->p_vblankYield();
+    
+    if(idle)
+    {
+      /**** check and sleep with interrupts off, a flag set in between would be a lost wake. a pending interrupt still wakes the cpu, the handler runs at ei ****/
+      di();
+      
+      if(!p_tms99XX->vblankFlag)
+      {
+        /**** idle keeps peripherals running, any interrupt wakes the cpu ****/
+        OSCCONbits.IDLEN = 1;
+        
+        SLEEP();
+      }
+      
+      ei();
+      
+      if(!p_tms99XX->vblankTimeout) continue;
+      
+      /**** timer time since the last wake, wraps are fine as long as something wakes the cpu more often ****/
+      di();
+      
+      now = readVDPtimer(p_tms99XX);
+      
+      ei();
+      
+      elapsed += (uint16_t)(now - last);
+      
+      last = now;
+      
+      if(elapsed >= deadline) return 0;
+    }
+    else if(p_tms99XX->vblankTimeout)
+    {
+      __delay_us(VBLANK_TICK_US);
+      
+      if(++ticks >= p_tms99XX->vblankTimeout) return 0;
+    }
+  }
+}
+
+/*** read VDP vram ***/
+inline int readVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t *p_data, int size, int modLen)
+{
+  int index = 0;
+  uint8_t paced = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+ 
+  if(!p_data) return 0;
+  
+  if(size <= 0) return 0;
+  
+  /**** combined bytes go out before anything is read back ****/
+  if(!flushVDPcombine(p_tms99XX)) return 0;
+  
+  /**** wait for interrupt ****/
+  /**** only wait if IRQ bit set and screen is not blank, with interrupts on so the cpu can do other work ****/
+  /**** for 4.3 miliseconds there is no access window waiting, total time is then 4 us ****/
+  /***** approx 1000 bytes can be handled ****/
+  paced = (uint8_t)(((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && ((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01));
+  
+  /**** the blank can close between the wait and the first byte, nothing moved is not a timeout, wait for the next one ****/
+  do
+  {
+    if(paced)
+    {
+      /**** timed out, nothing transferred ****/
+      if(!waitVDPvblank(p_tms99XX)) return 0;
+    }
+    
+    di();
+    
+    beginVDPbus(p_tms99XX);
+    
+    /**** after the wait, a register write from an interrupt in it moved the vdp address ****/
+    syncVDPvramAddr(p_tms99XX, 1);
+    
+    /**** set mode to 0 ****/
+    setVDPmode(p_tms99XX, 0);
+    
+    PROBE_ENTER(PROBE_ID_READ);
+    
+    /**** a write may have left the bus driven ****/
+    setVDPbusDir(p_tms99XX, BUS_INPUT);
+    
+    for(index = 0; index < size; index++)
+    {
+      /**** if irq is enabled, and blank is disabled, return index once the blank has run out ****/
+      /**** checked before the byte so index is the number of bytes moved ****/
+      if(paced)
+      {
+        /**** calibrated, stop at the measured deadline. if not, a fixed count that fits a 60 Hz blank at 48 MHz ****/
+        if(p_tms99XX->blankWindow ? !checkVDPblankOpen(p_tms99XX) : (index >= VBLANK_BYTE_LIMIT)) break;
+      }
+      
+      /**** set active low chip select read to 0 ****/
+      setCtrlMaskToZero(p_tms99XX, p_tms99XX->nCSRmask);
+      
+      /**** read data from port into array ****/
+      p_data[index % modLen] = *p_tms99XX->p_dataPortR;
+      
+      /**** set active low chip select read to 1 ****/
+      setCtrlMaskToOne(p_tms99XX, p_tms99XX->nCSRmask);
+      
+      /**** use worst case delay if IRQ is not set and we are not blanking the screen ****/
+      if(!((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && !((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01))
+      {
+        __delay_us(8);
+      }
+    }
+    
+    /**** status read below puts mode back to 1 ****/
+    
+    /**** this blank is used, the next transfer waits for a new one ****/
+    p_tms99XX->vblankFlag = 0;
+    
+    /**** status read clears the interrupt, also screws up access if done before data transfer  ****/
+    readVDPstatus(p_tms99XX);
+    
+    PROBE_EXIT();
+    
+    ei();
+  } while(!index);
+  
+  advanceVDPvramAddr(p_tms99XX, (uint16_t)index);
+  
+  return index;
+}
+
+/*** write VDP vram ***/
+inline int writeVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_data, int size, int modLen, uint8_t flash)
+{
+  int index = 0;
+  uint8_t paced = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_data) return 0;
+  
+  if(size <= 0) return 0;
+  
+  /**** combined bytes are older, they go first. the flush itself empties the buffer before it gets here ****/
+  if(!flushVDPcombine(p_tms99XX)) return 0;
+  
+  /**** wait for interrupt ****/
+  /**** only wait if IRQ bit set and screen is not blank, with interrupts on so the cpu can do other work ****/
+  /**** for 4.3 miliseconds there is no access window waiting, total time is then 4 us ****/
+  /***** approx 1000 bytes can be handled ****/
+  paced = (uint8_t)(((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && ((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01));
+  
+  /**** the blank can close between the wait and the first byte, nothing moved is not a timeout, wait for the next one ****/
+  do
+  {
+    if(paced)
+    {
+      /**** timed out, nothing transferred ****/
+      if(!waitVDPvblank(p_tms99XX)) return 0;
+    }
+    
+    di();
     
-    /**** write data to port from array of data at index ****/
-    *p_tms99XX->p_dataPortW = p_data[index % modLen];
+    beginVDPbus(p_tms99XX);
     
-    /**** set active low chip select write to 0 ****/
-    setCtrlBitToZero(p_tms99XX, p_tms99XX->nCSW);
+    /**** after the wait, a register write from an interrupt in it moved the vdp address ****/
+    syncVDPvramAddr(p_tms99XX, 0);
     
-    /**** set active low chip select write to 1 ****/
-    setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSW);
+    /**** set mode to 0 ****/
+    setVDPmode(p_tms99XX, 0);
     
-    if(!((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && !((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01))
+    PROBE_ENTER(PROBE_ID_WRITE);
+    
+    /**** set data bus to output ****/
+    setVDPbusDir(p_tms99XX, BUS_OUTPUT);
+    
+    /**** program memory is streamed with table reads, interrupts are off so nothing moves the table pointer ****/
+    if(flash)
     {
-      __delay_us(8);
+      TBLPTRU = (uint8_t)((uint24_t)p_data >> 16);
+      
+      TBLPTRH = (uint8_t)((uint24_t)p_data >> 8);
+      
+      TBLPTRL = (uint8_t)((uint24_t)p_data);
     }
     
-    /**** if irq is enabled, and blank is disabled, and index is 1000 or ever, return index since blank has run out ****/
-    if(((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && ((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01) && (index >= 1000))
+    for(index = 0; index < size; index++)
     {
-      break;
+      /**** if irq is enabled, and blank is disabled, return index once the blank has run out ****/
+      /**** checked before the byte so index is the number of bytes moved ****/
+      if(paced)
+      {
+        /**** calibrated, stop at the measured deadline. if not, a fixed count that fits a 60 Hz blank at 48 MHz ****/
+        if(p_tms99XX->blankWindow ? !checkVDPblankOpen(p_tms99XX) : (index >= VBLANK_BYTE_LIMIT)) break;
+      }
+      
+      if(flash)
+      {
+        /**** read next byte into TABLAT, post increment ****/
+        asm("TBLRD*+");
+        
+        *p_tms99XX->p_dataPortW = TABLAT;
+      }
+      else
+      {
+        /**** write data to port from array of data at index ****/
+        *p_tms99XX->p_dataPortW = p_data[index % modLen];
+      }
+      
+      /**** set active low chip select write to 0 ****/
+      setCtrlMaskToZero(p_tms99XX, p_tms99XX->nCSWmask);
+      
+      /**** set active low chip select write to 1 ****/
+      setCtrlMaskToOne(p_tms99XX, p_tms99XX->nCSWmask);
+      
+      if(!((p_tms99XX->register1 >> IRQ_BIT) & 0x01) && !((p_tms99XX->register1 >> BLK_SCRN_BIT) & 0x01))
+      {
+        __delay_us(8);
+      }
     }
-  }
-  
-  /**** set data bus to input ****/
-  *p_tms99XX->p_dataTRIS = 0xFF;
-  
-  /**** set mode to 1 ****/
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->mode);
+    
+    /**** status read below puts mode back to 1 and the bus to input ****/
+    
+    /**** this blank is used, the next transfer waits for a new one ****/
+    p_tms99XX->vblankFlag = 0;
+    
+    /**** status read clears the interrupt, also screws up access if done before data transfer ****/
+    readVDPstatus(p_tms99XX);
+    
+    PROBE_EXIT();
+    
+    ei();
+  } while(!index);
   
-  /**** status read clears the interrupt, also screws up access if done before data transfer ****/
-  readVDPstatus(p_tms99XX);
+  /**** write through to mirrors, an unknown address could have hit any of them, same for resident uploads ****/
+  if(p_tms99XX->vramAddrState == VRAM_ADDR_UNKNOWN)
+  {
+    invalidateTMS99XXvramMirrors(p_tms99XX);
+    
+    invalidateTMS99XXuploadCache(p_tms99XX);
+  }
+  else
+  {
+    writeVDPmirrors(p_tms99XX, p_tms99XX->vramAddr, p_data, (uint16_t)index, (uint16_t)modLen);
+    
+    invalidateVDPuploads(p_tms99XX, p_tms99XX->vramAddr, (uint16_t)index);
+  }
   
-  ei();
+  advanceVDPvramAddr(p_tms99XX, (uint16_t)index);
   
   return index;
 }
@@ -565,35 +1664,54 @@ inline void writeVDPregister(struct s_tms99XX * const p_tms99XX, uint8_t regNum,
   /**** NULL Check ****/
   if(!p_tms99XX) return;
   
+  /**** combined bytes go out before the register write loses the address. on a timeout they stay with their own address ****/
+  flushVDPcombine(p_tms99XX);
+  
   di();
   
-  /**** set data bus to output ****/
-  *p_tms99XX->p_dataTRIS = 0x00;
+  PROBE_ENTER(PROBE_ID_REG);
+  
+  writeVDPregisterRaw(p_tms99XX, regNum, data);
+  
+  PROBE_EXIT();
   
-  /**** no need to set mode to 1 for register mode ****/
+  /**** the first byte of a register write lands in the vdp address register ****/
+  p_tms99XX->vramAddrState = VRAM_ADDR_UNKNOWN;
+
+  ei();
+}
+
+/*** write VDP registers, interrupts must already be off ***/
+inline void writeVDPregisterRaw(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t data)
+{
+  /**** no probe here, the callers probe main level and interrupt writes on their own pins ****/
+  beginVDPbus(p_tms99XX);
+  
+  /**** set data bus to output, back to back register writes skip this ****/
+  setVDPbusDir(p_tms99XX, BUS_OUTPUT);
+  
+  /**** register mode ****/
+  setVDPmode(p_tms99XX, 1);
   
   /**** output data over bus ****/
   *p_tms99XX->p_dataPortW = data;
   
   /**** set chip select write to low ****/
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->nCSW);
+  setCtrlMaskToZero(p_tms99XX, p_tms99XX->nCSWmask);
   
   /**** set chip select write to high ****/
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSW);
+  setCtrlMaskToOne(p_tms99XX, p_tms99XX->nCSWmask);
   
   /**** write msb as 1 and reg num to lower 3 bits ****/
   *p_tms99XX->p_dataPortW = (unsigned char)(0x80 | regNum);
   
   /**** set chip select write to low ****/
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->nCSW);
+  setCtrlMaskToZero(p_tms99XX, p_tms99XX->nCSWmask);
   
   /**** set chip select write to high ****/
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSW);
+  setCtrlMaskToOne(p_tms99XX, p_tms99XX->nCSWmask);
   
-  /**** set data bus to input ****/
-  *p_tms99XX->p_dataTRIS = 0xFF;
-
-  ei();
+  /**** bus stays driven, the next read switches it ****/
 }
 
 /*** set write or read VDP vram address ***/
@@ -602,35 +1720,62 @@ inline void writeVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint16_t addres
   /**** NULL Check ****/
   if(!p_tms99XX) return;
   
+  if(p_tms99XX->p_combine && p_tms99XX->p_combine->count)
+  {
+    /**** continuing the combined write, auto increment gets there with no address ****/
+    if(!rnw && (p_tms99XX->vramAddr == p_tms99XX->p_combine->vramAddr) && (((p_tms99XX->p_combine->vramAddr + p_tms99XX->p_combine->count) & VRAM_ADDR_MASK) == (address & VRAM_ADDR_MASK))) return;
+    
+    /**** combined bytes belong to the old address. on a timeout they stay with their own address for the next flush ****/
+    flushVDPcombine(p_tms99XX);
+  }
+  
   di();
   
-  /**** no need to set mode to 1 for register mode ****/
+  PROBE_ENTER(PROBE_ID_ADDR);
+  
+  beginVDPbus(p_tms99XX);
+  
+  writeVDPvramAddrRaw(p_tms99XX, address, rnw);
+  
+  PROBE_EXIT();
+  
+  ei();
+}
+
+/*** set write or read VDP vram address, interrupts must already be off and the bus begun ***/
+inline void writeVDPvramAddrRaw(struct s_tms99XX * const p_tms99XX, uint16_t address, int rnw)
+{
+  /**** register mode ****/
+  setVDPmode(p_tms99XX, 1);
   
   /**** set data bus to output ****/
-  *p_tms99XX->p_dataTRIS = 0x00;
+  setVDPbusDir(p_tms99XX, BUS_OUTPUT);
   
   /**** output bottom 8 bits of 14 bit address ****/
   *p_tms99XX->p_dataPortW = (unsigned char)(0xFF & address);
   
   /**** set chip select write to low ****/
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->nCSW);
+  setCtrlMaskToZero(p_tms99XX, p_tms99XX->nCSWmask);
   
   /**** set chip select write to high ****/
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSW);
+  setCtrlMaskToOne(p_tms99XX, p_tms99XX->nCSWmask);
   
   /**** write bit 7 as 0, 6 as 1, and rest are top 6 bits of address ****/
   *p_tms99XX->p_dataPortW = (unsigned char)((rnw != 0 ? 0x00 : 0x40) | (unsigned char)(0x3F & (address >> 8)));
   
   /**** set chip select write to low ****/
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->nCSW);
+  setCtrlMaskToZero(p_tms99XX, p_tms99XX->nCSWmask);
 
   /**** set chip select write to high ****/
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->nCSW);
+  setCtrlMaskToOne(p_tms99XX, p_tms99XX->nCSWmask);
 
-  /**** set data bus to input ****/
-  *p_tms99XX->p_dataTRIS = 0xFF;
+  /**** bus stays driven, a data write right after skips the TRIS write ****/
   
-  ei();
+  p_tms99XX->vramAddr = address & VRAM_ADDR_MASK;
+  
+  p_tms99XX->vramAddrState = VRAM_ADDR_SYNC;
+  
+  p_tms99XX->vramAddrRead = (rnw != 0);
 }
 
 /*** set modes by setting vdpMode ***/
@@ -657,11 +1802,11 @@ inline void initVDPmode(struct s_tms99XX * const p_tms99XX)
   
   if(p_tms99XX->vdpMode == GFXII_MODE)
   {
-    /**** setup register 3 for a color table address GFX II has two fixed values for its only two addresses ****/
-    writeVDPregister(p_tms99XX, REGISTER_3, (unsigned char)((p_tms99XX->colorTableAddr == 0x0000) ? 0x7F : 0xFF));
+    /**** setup register 3 for a color table address GFX II has two addresses, low bits mask the thirds ****/
+    writeVDPregister(p_tms99XX, REGISTER_3, getTMS99XXgfx2Reg(p_tms99XX, REGISTER_3));
     
-    /**** setup register 4 for pattern table address GFX II has two fixed values for its only two addresses  ****/
-    writeVDPregister(p_tms99XX, REGISTER_4, (unsigned char)((p_tms99XX->patternTableAddr == 0x0000) ? 0x03 : 0x07));
+    /**** setup register 4 for pattern table address GFX II has two addresses, low bits mask the thirds ****/
+    writeVDPregister(p_tms99XX, REGISTER_4, getTMS99XXgfx2Reg(p_tms99XX, REGISTER_4));
   }
   else
   {
@@ -689,6 +1834,22 @@ inline void initVDPmode(struct s_tms99XX * const p_tms99XX)
   writeVDPregister(p_tms99XX, REGISTER_7, p_tms99XX->colorReg);
 }
 
+/*** graphics II mask bits, register 3 bits 6-5 and register 4 bits 1-0 mask the third ***/
+inline uint8_t getVDPgfx2Mask(uint8_t gfx2Thirds, uint8_t regNum)
+{
+  switch(gfx2Thirds)
+  {
+    case GFX2_THIRDS_SHARED:
+      return (uint8_t)(regNum == REGISTER_3 ? 0x1F : 0x00);
+    case GFX2_THIRDS_MIXED:
+      return (uint8_t)(regNum == REGISTER_3 ? 0x7F : 0x00);
+    case GFX2_THIRDS_HYBRID:
+      return (uint8_t)(regNum == REGISTER_3 ? 0x5F : 0x02);
+    default:
+      return (uint8_t)(regNum == REGISTER_3 ? 0x7F : 0x03);
+  }
+}
+
 /*** reset vdp ***/
 inline void resetVDP(struct s_tms99XX * const p_tms99XX)
 {
@@ -697,26 +1858,415 @@ inline void resetVDP(struct s_tms99XX * const p_tms99XX)
   
   di();
   
+  beginVDPbus(p_tms99XX);
+  
   /**** set reset to 0 to put vdp into reset mode ****/
-  setCtrlBitToZero(p_tms99XX, p_tms99XX->nreset);
+  setCtrlMaskToZero(p_tms99XX, p_tms99XX->nresetMask);
   
   /**** delay the needed amount of time per the ti data sheet ****/
   __delay_us(3);
   
   /**** set reset to 1 to take vdp out of reset mode ****/
-  setCtrlBitToOne(p_tms99XX, p_tms99XX->nreset);
+  setCtrlMaskToOne(p_tms99XX, p_tms99XX->nresetMask);
   
   ei();
 }
 
-/*** set bit to one ***/
-inline void setCtrlBitToOne(struct s_tms99XX * const p_tms99XX, uint8_t bitNum)
+/*** read 16 bit timer, low byte first so the high byte is latched with it. interrupts off, another read in between would latch a new high byte ***/
+inline uint16_t readVDPtimer(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t low = *p_tms99XX->p_timerL;
+  
+  return (uint16_t)(((uint16_t)*p_tms99XX->p_timerH << 8) | low);
+}
+
+/*** 1 while the blank started at the stamp is still open ***/
+inline uint8_t checkVDPblankOpen(struct s_tms99XX * const p_tms99XX)
+{
+  /**** no timer, the flag is all there is ****/
+  if(!p_tms99XX->blankWindow) return 1;
+  
+  return (uint16_t)(readVDPtimer(p_tms99XX) - p_tms99XX->vblankStamp) < p_tms99XX->blankWindow;
+}
+
+/*** set the vdp address again when it lags or the direction changed, interrupts must already be off ***/
+inline void syncVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint8_t rnw)
+{
+  /**** nothing to go back to, transfer goes wherever the vdp points ****/
+  if(p_tms99XX->vramAddrState == VRAM_ADDR_UNKNOWN) return;
+  
+  /**** read setup prefetches a byte, writing after it would land one past the tracked address ****/
+  if((p_tms99XX->vramAddrState == VRAM_ADDR_LAG) || (p_tms99XX->vramAddrRead != rnw))
+  {
+    writeVDPvramAddrRaw(p_tms99XX, p_tms99XX->vramAddr, rnw);
+  }
+}
+
+/*** move the tracked address past a transfer ***/
+inline void advanceVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint16_t size)
+{
+  if(p_tms99XX->vramAddrState == VRAM_ADDR_UNKNOWN) return;
+  
+  p_tms99XX->vramAddr = (p_tms99XX->vramAddr + size) & VRAM_ADDR_MASK;
+}
+
+/*** find a valid mirror holding the whole range ***/
+inline struct s_tms99XX_mirror *findVDPmirror(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size)
+{
+  struct s_tms99XX_mirror *p_mirror = NULL;
+  
+  if(p_tms99XX->vramAddrState == VRAM_ADDR_UNKNOWN) return NULL;
+  
+  for(p_mirror = p_tms99XX->p_mirrors; p_mirror; p_mirror = p_mirror->p_next)
+  {
+    if(!p_mirror->valid) continue;
+    
+    if(vramAddr < p_mirror->vramAddr) continue;
+    
+    /**** 14 bit address plus 16K size fits 16 bits ****/
+    if((uint16_t)(vramAddr + size) > (uint16_t)(p_mirror->vramAddr + p_mirror->size)) continue;
+    
+    return p_mirror;
+  }
+  
+  return NULL;
+}
+
+/*** copy written data into overlapping mirrors, data is either one byte repeated or size long ***/
+inline void writeVDPmirrors(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint8_t const * const p_data, uint16_t size, uint16_t modLen)
+{
+  uint16_t start = 0;
+  uint16_t end = 0;
+  
+  struct s_tms99XX_mirror *p_mirror = NULL;
+  
+  for(p_mirror = p_tms99XX->p_mirrors; p_mirror; p_mirror = p_mirror->p_next)
+  {
+    if(!p_mirror->valid) continue;
+    
+    start = (vramAddr > p_mirror->vramAddr ? vramAddr : p_mirror->vramAddr);
+    
+    end = (uint16_t)(vramAddr + size);
+    
+    if(end > (uint16_t)(p_mirror->vramAddr + p_mirror->size)) end = (uint16_t)(p_mirror->vramAddr + p_mirror->size);
+    
+    if(start >= end) continue;
+    
+    if(modLen == 1)
+    {
+      memset(&p_mirror->p_buffer[start - p_mirror->vramAddr], *p_data, end - start);
+    }
+    else
+    {
+      memcpy(&p_mirror->p_buffer[start - p_mirror->vramAddr], &p_data[start - vramAddr], end - start);
+    }
+    
+    p_mirror->bytesWrote += (uint32_t)(end - start);
+  }
+}
+
+/*** set mask bits to one, shadow write instead of a read-modify-write of the latch ***/
+inline void setCtrlMaskToOne(struct s_tms99XX * const p_tms99XX, uint8_t mask)
+{
+  p_tms99XX->ctrlShadow |= mask;
+  
+  *p_tms99XX->p_ctrlPortW = p_tms99XX->ctrlShadow;
+}
+
+/*** set mask bits to zero, shadow write instead of a read-modify-write of the latch ***/
+inline void setCtrlMaskToZero(struct s_tms99XX * const p_tms99XX, uint8_t mask)
+{
+  p_tms99XX->ctrlShadow &= (unsigned char)~mask;
+  
+  *p_tms99XX->p_ctrlPortW = p_tms99XX->ctrlShadow;
+}
+
+/*** start of a bus access, interrupts must be off ***/
+inline void beginVDPbus(struct s_tms99XX * const p_tms99XX)
+{
+  /**** one latch read per access, other pins on the port may have changed since ****/
+  p_tms99XX->ctrlShadow = *p_tms99XX->p_ctrlPortW;
+  
+  /**** another struct drove the same pins, cached TRIS and mode are stale ****/
+  if(gp_tms99XXbusOwner != p_tms99XX)
+  {
+    p_tms99XX->busDir = BUS_UNKNOWN;
+    
+    p_tms99XX->modeLevel = BUS_UNKNOWN;
+    
+    gp_tms99XXbusOwner = p_tms99XX;
+  }
+}
+
+/*** set data bus direction if it changed ***/
+inline void setVDPbusDir(struct s_tms99XX * const p_tms99XX, uint8_t busDir)
+{
+  if(p_tms99XX->busDir == busDir) return;
+  
+  *p_tms99XX->p_dataTRIS = (busDir == BUS_OUTPUT ? 0x00 : 0xFF);
+  
+  p_tms99XX->busDir = busDir;
+}
+
+/*** set mode line if it changed ***/
+inline void setVDPmode(struct s_tms99XX * const p_tms99XX, uint8_t level)
+{
+  if(p_tms99XX->modeLevel == level) return;
+  
+  if(level)
+  {
+    setCtrlMaskToOne(p_tms99XX, p_tms99XX->modeMask);
+  }
+  else
+  {
+    setCtrlMaskToZero(p_tms99XX, p_tms99XX->modeMask);
+  }
+  
+  p_tms99XX->modeLevel = level;
+}
+
+/*** upload unless the same data is resident at the same address ***/
+inline uint8_t uploadVDPvram(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint8_t const *p_data, uint16_t size, uint8_t flash)
+{
+  int amtWrote = 0;
+  uint8_t index = 0;
+  uint16_t hash = 0;
+  uint16_t sent = 0;
+  
+  struct s_tms99XX_uploadCache *p_uploadCache = p_tms99XX->p_uploadCache;
+  
+  if(!size) return 1;
+  
+  /**** a combined write could still land over a resident upload ****/
+  if(!flushVDPcombine(p_tms99XX)) return 0;
+  
+  vramAddr &= VRAM_ADDR_MASK;
+  
+  /**** hashing is a RAM or table read per byte, far less than a paced bus write ****/
+  if(p_uploadCache)
+  {
+    hash = hashVDPdata(p_data, size);
+    
+    if(findVDPupload(p_uploadCache, vramAddr, size, hash))
+    {
+      p_uploadCache->hits++;
+      
+      return 1;
+    }
+    
+    p_uploadCache->misses++;
+  }
+  
+  /**** no address write here, the first piece sets it inside its di section after the wait ****/
+  p_tms99XX->vramAddr = vramAddr;
+  
+  p_tms99XX->vramAddrRead = 0;
+  
+  p_tms99XX->vramAddrState = VRAM_ADDR_LAG;
+  
+  /**** each piece forgets the uploads it overlaps, including an old one here ****/
+  for(sent = 0; sent < size; sent += (uint16_t)amtWrote)
+  {
+    amtWrote = writeVDPvram(p_tms99XX, &p_data[sent], (int)(size - sent), (int)(size - sent), flash);
+    
+    if(!amtWrote) return 0;
+  }
+  
+  if(!p_uploadCache) return 1;
+  
+  /**** empty entry first, else round robin ****/
+  for(index = 0; index < UPLOAD_CACHE_ENTRIES; index++)
+  {
+    if(!p_uploadCache->uploads[index].size) break;
+  }
+  
+  if(index >= UPLOAD_CACHE_ENTRIES)
+  {
+    index = p_uploadCache->next;
+    
+    p_uploadCache->next = (uint8_t)((p_uploadCache->next + 1) % UPLOAD_CACHE_ENTRIES);
+  }
+  
+  p_uploadCache->uploads[index].vramAddr = vramAddr;
+  
+  p_uploadCache->uploads[index].size = size;
+  
+  p_uploadCache->uploads[index].hash = hash;
+  
+  return 1;
+}
+
+/*** crc 16 ccitt (0x1021, start 0xFFFF), a byte at a time with shifts, no table. any one or two bit change and any burst up to 16 bits changes it ***/
+inline uint16_t hashVDPdata(uint8_t const *p_data, uint16_t size)
+{
+  uint8_t  x = 0;
+  uint16_t crc = 0xFFFF;
+  
+  for(; size > 0; size--)
+  {
+    x = (uint8_t)((crc >> 8) ^ *p_data++);
+    
+    x ^= (uint8_t)(x >> 4);
+    
+    crc = (uint16_t)((crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x);
+  }
+  
+  return crc;
+}
+
+/*** 1 if the table holds the block as resident ***/
+inline uint8_t findVDPupload(struct s_tms99XX_uploadCache const * const p_uploadCache, uint16_t vramAddr, uint16_t size, uint16_t hash)
+{
+  uint8_t index = 0;
+  
+  for(index = 0; index < UPLOAD_CACHE_ENTRIES; index++)
+  {
+    if(p_uploadCache->uploads[index].size != size) continue;
+    
+    if(p_uploadCache->uploads[index].vramAddr != vramAddr) continue;
+    
+    if(p_uploadCache->uploads[index].hash != hash) continue;
+    
+    return 1;
+  }
+  
+  return 0;
+}
+
+/*** forget uploads a write overlaps ***/
+inline void invalidateVDPuploads(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size)
+{
+  uint8_t index = 0;
+  uint32_t end = (uint32_t)vramAddr + size;
+  
+  struct s_tms99XX_upload *p_upload = NULL;
+  
+  if(!p_tms99XX->p_uploadCache) return;
+  
+  if(!size) return;
+  
+  /**** wrapped past 0x3FFF, rare enough to forget everything ****/
+  if(end > MEM_SIZE)
+  {
+    invalidateTMS99XXuploadCache(p_tms99XX);
+    
+    return;
+  }
+  
+  for(index = 0; index < UPLOAD_CACHE_ENTRIES; index++)
+  {
+    p_upload = &p_tms99XX->p_uploadCache->uploads[index];
+    
+    if(!p_upload->size) continue;
+    
+    if((vramAddr < ((uint32_t)p_upload->vramAddr + p_upload->size)) && (p_upload->vramAddr < end))
+    {
+      p_upload->size = 0;
+    }
+  }
+}
+
+/*** add a small write to the combine buffer ***/
+inline uint8_t combineVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_data, int size)
 {
-  *p_tms99XX->p_ctrlPortW |= (unsigned char)(1 << bitNum);
+  struct s_tms99XX_combine *p_combine = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_data) return 0;
+  
+  p_combine = p_tms99XX->p_combine;
+  
+  if(!p_combine) return 0;
+  
+  /**** big writes are a burst already, an unknown address can't be continued ****/
+  if((size <= 0) || (size > COMBINE_BUFFER_SIZE)) return 0;
+  
+  if(p_tms99XX->vramAddrState == VRAM_ADDR_UNKNOWN) return 0;
+  
+  /**** full, or bytes left by a timed out flush for another address ****/
+  if(((p_combine->count + size) > COMBINE_BUFFER_SIZE) || (p_combine->count && (p_combine->vramAddr != p_tms99XX->vramAddr)))
+  {
+    if(!flushVDPcombine(p_tms99XX)) return 0;
+  }
+  
+  /**** the vdp address does not move while bytes wait, the buffer starts here ****/
+  if(!p_combine->count) p_combine->vramAddr = p_tms99XX->vramAddr;
+  
+  /**** ram or program memory, both read through a const pointer ****/
+  memcpy(&p_combine->buffer[p_combine->count], p_data, (size_t)size);
+  
+  p_combine->count += (uint8_t)size;
+  
+  p_combine->writes++;
+  
+  return 1;
 }
 
-/*** set bit to zero ***/
-inline void setCtrlBitToZero(struct s_tms99XX * const p_tms99XX, uint8_t bitNum)
+/*** write the combine buffer as one burst ***/
+inline uint8_t flushVDPcombine(struct s_tms99XX * const p_tms99XX)
 {
-  *p_tms99XX->p_ctrlPortW &= (unsigned char)~(1 << bitNum);
+  int amtWrote = 0;
+  uint8_t index = 0;
+  uint8_t count = 0;
+  uint8_t moved = 0;
+  uint8_t addrState = 0;
+  uint8_t addrRead = 0;
+  uint16_t addr = 0;
+  
+  struct s_tms99XX_combine *p_combine = p_tms99XX->p_combine;
+  
+  if(!p_combine) return 1;
+  
+  if(!p_combine->count) return 1;
+  
+  /**** empty before writing, writeVDPvram and writeVDPvramAddr flush first ****/
+  count = p_combine->count;
+  
+  p_combine->count = 0;
+  
+  p_combine->bursts++;
+  
+  /**** bytes kept by a timed out flush, the address moved on since. send them where they belong, put the tracked address back after ****/
+  if((p_tms99XX->vramAddrState == VRAM_ADDR_UNKNOWN) || (p_tms99XX->vramAddr != p_combine->vramAddr))
+  {
+    moved = 1;
+    
+    addrState = p_tms99XX->vramAddrState;
+    
+    addrRead = p_tms99XX->vramAddrRead;
+    
+    addr = p_tms99XX->vramAddr;
+    
+    writeVDPvramAddr(p_tms99XX, p_combine->vramAddr, 0);
+  }
+  
+  for(index = 0; index < count; index += (uint8_t)amtWrote)
+  {
+    amtWrote = writeVDPvram(p_tms99XX, &p_combine->buffer[index], count - index, count - index, 0);
+    
+    if(!amtWrote) break;
+  }
+  
+  if(moved)
+  {
+    p_tms99XX->vramAddr = addr;
+    
+    p_tms99XX->vramAddrRead = addrRead;
+    
+    /**** the vdp is somewhere else now, the next transfer sets it again ****/
+    p_tms99XX->vramAddrState = (addrState == VRAM_ADDR_UNKNOWN ? VRAM_ADDR_UNKNOWN : VRAM_ADDR_LAG);
+  }
+  
+  if(index >= count) return 1;
+  
+  /**** timed out, keep the rest and its address till a flush sends it ****/
+  memmove(p_combine->buffer, &p_combine->buffer[index], count - index);
+  
+  p_combine->vramAddr = (uint16_t)((p_combine->vramAddr + index) & VRAM_ADDR_MASK);
+  
+  p_combine->count = (uint8_t)(count - index);
+  
+  return 0;
 }
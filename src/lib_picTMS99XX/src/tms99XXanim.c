@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * @file    tms99XXanim.c
+ * @brief   Bank switched animation for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Animation by table bank switching. Registers 3, 4 and 6 point the
+ *          color, pattern and sprite pattern tables at any aligned block of
+ *          VRAM, so every frame of an animation is preloaded into its own bank
+ *          once. Showing the next frame is then one register write instead of a
+ *          table upload, ex. color cycling, animated water tiles or sprite
+ *          animation frames. Bank addresses can come from a layout planned with
+ *          more than one bank per table. The sequencer counts frames, call
+ *          stepTMS99XXanim once per frame right after the vertical blank.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXanim.h>
+#include <tms99XXlayout.h>
+
+/** SEE MY PRIVATES **/
+/*** point the table register at a vram address ***/
+inline void setAnimReg(struct s_tms99XX * const p_tms99XX, uint8_t table, uint16_t vramAddr);
+
+/*** setup animation ***/
+void initTMS99XXanim(struct s_tms99XX_anim * const p_anim, struct s_tms99XX * const p_tms99XX, uint8_t table)
+{
+  /**** NULL Check ****/
+  if(!p_anim) return;
+  
+  if(!p_tms99XX) return;
+  
+  p_anim->p_tms99XX = p_tms99XX;
+  
+  p_anim->p_sequence = NULL;
+  
+  p_anim->table = table;
+  
+  p_anim->numBanks = 0;
+  
+  p_anim->numSteps = 0;
+  
+  p_anim->step = 0;
+  
+  p_anim->framesPerStep = 1;
+  
+  p_anim->frameCount = 0;
+}
+
+/*** preload a bank ***/
+uint8_t addTMS99XXanimBank(struct s_tms99XX_anim * const p_anim, uint16_t vramAddr, void const * const p_data, uint16_t size)
+{
+  uint16_t align = 0;
+  
+  /**** NULL Check ****/
+  if(!p_anim) return ANIM_NO_BANK;
+  
+  if(p_anim->numBanks >= ANIM_MAX_BANKS) return ANIM_NO_BANK;
+  
+  align = getTMS99XXlayoutAlign(p_anim->p_tms99XX->vdpMode, p_anim->table);
+  
+  /**** registers 3, 4 and 6 only hold the top address bits ****/
+  if(!align || (vramAddr & (align - 1))) return ANIM_NO_BANK;
+  
+  if(p_data)
+  {
+    setTMS99XXvramWriteAddr(p_anim->p_tms99XX, vramAddr);
+    
+    if(!setTMS99XXvramBlock(p_anim->p_tms99XX, p_data, size, VRAM_SRC_RAM)) return ANIM_NO_BANK;
+  }
+  
+  p_anim->bankAddr[p_anim->numBanks] = vramAddr;
+  
+  return p_anim->numBanks++;
+}
+
+/*** set sequencer ***/
+void setTMS99XXanimSequence(struct s_tms99XX_anim * const p_anim, uint8_t framesPerStep, uint8_t const * const p_sequence, uint8_t numSteps)
+{
+  /**** NULL Check ****/
+  if(!p_anim) return;
+  
+  p_anim->framesPerStep = framesPerStep;
+  
+  p_anim->p_sequence = p_sequence;
+  
+  p_anim->numSteps = (p_sequence ? numSteps : 0);
+  
+  p_anim->step = 0;
+  
+  p_anim->frameCount = 0;
+}
+
+/*** count a frame, switch bank when due ***/
+uint8_t stepTMS99XXanim(struct s_tms99XX_anim * const p_anim)
+{
+  uint8_t bank = 0;
+  uint8_t numSteps = 0;
+  
+  /**** NULL Check ****/
+  if(!p_anim) return 0;
+  
+  if(!p_anim->framesPerStep) return 0;
+  
+  if(!p_anim->numBanks) return 0;
+  
+  if(++p_anim->frameCount < p_anim->framesPerStep) return 0;
+  
+  p_anim->frameCount = 0;
+  
+  numSteps = (p_anim->p_sequence ? p_anim->numSteps : p_anim->numBanks);
+  
+  if(!numSteps) return 0;
+  
+  if(++p_anim->step >= numSteps) p_anim->step = 0;
+  
+  bank = (p_anim->p_sequence ? p_anim->p_sequence[p_anim->step] : p_anim->step);
+  
+  if(bank >= p_anim->numBanks) return 0;
+  
+  setAnimReg(p_anim->p_tms99XX, p_anim->table, p_anim->bankAddr[bank]);
+  
+  return 1;
+}
+
+/*** show a bank now ***/
+void showTMS99XXanimBank(struct s_tms99XX_anim * const p_anim, uint8_t bank)
+{
+  /**** NULL Check ****/
+  if(!p_anim) return;
+  
+  if(bank >= p_anim->numBanks) return;
+  
+  setAnimReg(p_anim->p_tms99XX, p_anim->table, p_anim->bankAddr[bank]);
+}
+
+/** SEE MY PRIVATES **/
+/*** one register write, keeps the struct table address in step for uploads ***/
+inline void setAnimReg(struct s_tms99XX * const p_tms99XX, uint8_t table, uint16_t vramAddr)
+{
+  switch(table)
+  {
+    case LAYOUT_COLOR:
+      p_tms99XX->colorTableAddr = vramAddr;
+      
+      /**** graphics II keeps its third sharing mask bits ****/
+      if(p_tms99XX->vdpMode == GFXII_MODE)
+      {
+        setTMS99XXreg(p_tms99XX, REGISTER_3, getTMS99XXgfx2Reg(p_tms99XX, REGISTER_3));
+      }
+      else
+      {
+        setTMS99XXreg(p_tms99XX, REGISTER_3, (uint8_t)(vramAddr >> COLOR_TABLE_ADDR_SCALE));
+      }
+      break;
+    case LAYOUT_PATTERN:
+      p_tms99XX->patternTableAddr = vramAddr;
+      
+      if(p_tms99XX->vdpMode == GFXII_MODE)
+      {
+        setTMS99XXreg(p_tms99XX, REGISTER_4, getTMS99XXgfx2Reg(p_tms99XX, REGISTER_4));
+      }
+      else
+      {
+        setTMS99XXreg(p_tms99XX, REGISTER_4, (uint8_t)(vramAddr >> PATTERN_TABLE_ADDR_SCALE));
+      }
+      break;
+    case LAYOUT_SPRITE_PATTERN:
+      p_tms99XX->spritePatternAddr = vramAddr;
+      
+      setTMS99XXreg(p_tms99XX, REGISTER_6, (uint8_t)(vramAddr >> SPRITE_PATTERN_TABLE_ADDR_SCALE));
+      break;
+    default:
+      break;
+  }
+}
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * @file    tms99XXbmp.c
+ * @brief   Multicolor framebuffer for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details 64x48 multicolor(bitmap) mode framebuffer kept in RAM as
+ *          packed nibbles. The name table is installed once so pattern
+ *          block n holds screen columns 2n, 2n+1 of an 8 pixel tall band.
+ *          A packed framebuffer row then is the same byte as its pattern
+ *          row, commit only gathers the changed 8 byte blocks.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXbmp.h>
+
+/** SEE MY PRIVATES **/
+/*** write a run of blocks ending at lastBlock, marks them changed again and returns 0 if a transfer timed out ***/
+inline uint8_t writeBmpData(struct s_tms99XX_bmp * const p_bmp, uint8_t const *p_data, uint8_t size, uint8_t lastBlock);
+
+/*** setup multicolor framebuffer ***/
+uint8_t initTMS99XXbmp(struct s_tms99XX_bmp * const p_bmp, struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t row = 0;
+  uint8_t col = 0;
+  uint8_t nameRow[32];
+  
+  /**** NULL Check ****/
+  if(!p_bmp) return 0;
+  
+  if(!p_tms99XX) return 0;
+  
+  p_bmp->p_tms99XX = p_tms99XX;
+  
+  if(p_tms99XX->vdpMode != BMP_MODE)
+  {
+    setTMS99XXmode(p_tms99XX, BMP_MODE);
+  }
+  
+  /**** name rows repeat every 4 rows, so each block covers an 8 pixel band ****/
+  setTMS99XXvramWriteAddr(p_tms99XX, p_tms99XX->nameTableAddr);
+  
+  for(row = 0; row < 24; row++)
+  {
+    for(col = 0; col < sizeof(nameRow); col++)
+    {
+      nameRow[col] = (uint8_t)(((row >> 2) << 5) | col);
+    }
+    
+    if(!setTMS99XXvramBlock(p_tms99XX, nameRow, sizeof(nameRow), VRAM_SRC_RAM)) return 0;
+  }
+  
+  /**** start with everything changed so the pattern table is cleared ****/
+  memset(p_bmp->pixels, 0, sizeof(p_bmp->pixels));
+  
+  memset(p_bmp->dirty, 0xFF, sizeof(p_bmp->dirty));
+  
+  return commitTMS99XXbmp(p_bmp);
+}
+
+/*** set pixel ***/
+void setTMS99XXbmpPixel(struct s_tms99XX_bmp * const p_bmp, uint8_t x, uint8_t y, uint8_t color)
+{
+  uint8_t  block = 0;
+  uint8_t  data = 0;
+  uint8_t *p_pixel = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_bmp) return;
+  
+  if((x >= BMP_WIDTH) || (y >= BMP_HEIGHT)) return;
+  
+  p_pixel = &p_bmp->pixels[((uint16_t)y << 5) | (x >> 1)];
+  
+  if(x & 0x01)
+  {
+    data = (uint8_t)((*p_pixel & 0xF0) | (color & 0x0F));
+  }
+  else
+  {
+    data = (uint8_t)((*p_pixel & 0x0F) | ((color & 0x0F) << 4));
+  }
+  
+  if(data == *p_pixel) return;
+  
+  *p_pixel = data;
+  
+  /**** block number is the 8 pixel band times 32 plus the byte column ****/
+  block = (uint8_t)(((y >> 3) << 5) | (x >> 1));
+  
+  p_bmp->dirty[block >> 3] |= (uint8_t)(1 << (block & 0x07));
+}
+
+/*** get pixel ***/
+uint8_t getTMS99XXbmpPixel(struct s_tms99XX_bmp * const p_bmp, uint8_t x, uint8_t y)
+{
+  uint8_t data = 0;
+  
+  /**** NULL Check ****/
+  if(!p_bmp) return 0;
+  
+  if((x >= BMP_WIDTH) || (y >= BMP_HEIGHT)) return 0;
+  
+  data = p_bmp->pixels[((uint16_t)y << 5) | (x >> 1)];
+  
+  return (uint8_t)((x & 0x01) ? (data & 0x0F) : (data >> 4));
+}
+
+/*** fill framebuffer ***/
+void fillTMS99XXbmp(struct s_tms99XX_bmp * const p_bmp, uint8_t color)
+{
+  /**** NULL Check ****/
+  if(!p_bmp) return;
+  
+  memset(p_bmp->pixels, (color & 0x0F) * 0x11, sizeof(p_bmp->pixels));
+  
+  memset(p_bmp->dirty, 0xFF, sizeof(p_bmp->dirty));
+}
+
+/*** write changed blocks ***/
+uint8_t commitTMS99XXbmp(struct s_tms99XX_bmp * const p_bmp)
+{
+  uint8_t  block = 0;
+  uint8_t  row = 0;
+  uint8_t  runLen = 0;
+  uint8_t  inRun = 0;
+  uint8_t  buffer[64];
+  uint8_t *p_src = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_bmp) return 0;
+  
+  for(block = 0; block < BMP_BLOCKS; block++)
+  {
+    if(!(p_bmp->dirty[block >> 3] & (1 << (block & 0x07))))
+    {
+      /**** gap ends the run, next dirty block needs an address ****/
+      if(runLen && !writeBmpData(p_bmp, buffer, runLen, (uint8_t)(block - 1))) return 0;
+      
+      runLen = 0;
+      
+      inRun = 0;
+      
+      continue;
+    }
+    
+    p_bmp->dirty[block >> 3] &= (uint8_t)~(1 << (block & 0x07));
+    
+    if(!inRun)
+    {
+      setTMS99XXvramWriteAddr(p_bmp->p_tms99XX, (uint16_t)(p_bmp->p_tms99XX->patternTableAddr + ((uint16_t)block << 3)));
+      
+      inRun = 1;
+    }
+    
+    /**** gather the 8 rows of the band, 32 bytes apart in the framebuffer ****/
+    p_src = &p_bmp->pixels[((uint16_t)(block >> 5) << 8) | (block & 0x1F)];
+    
+    for(row = 0; row < 8; row++)
+    {
+      buffer[runLen++] = p_src[(uint16_t)row << 5];
+    }
+    
+    /**** buffer full, address keeps auto incrementing for the rest of the run ****/
+    if(runLen >= sizeof(buffer))
+    {
+      if(!writeBmpData(p_bmp, buffer, runLen, block)) return 0;
+      
+      runLen = 0;
+    }
+  }
+  
+  if(runLen) return writeBmpData(p_bmp, buffer, runLen, (uint8_t)(BMP_BLOCKS - 1));
+  
+  return 1;
+}
+
+/** SEE MY PRIVATES **/
+/*** write a run, a block is 8 bytes so the run is the size / 8 blocks up to lastBlock ***/
+inline uint8_t writeBmpData(struct s_tms99XX_bmp * const p_bmp, uint8_t const *p_data, uint8_t size, uint8_t lastBlock)
+{
+  uint8_t block = 0;
+  
+  if(setTMS99XXvramBlock(p_bmp->p_tms99XX, p_data, size, VRAM_SRC_RAM)) return 1;
+  
+  /**** keep them for the next commit ****/
+  for(block = (uint8_t)(lastBlock + 1 - (size >> 3)); block <= lastBlock; block++)
+  {
+    p_bmp->dirty[block >> 3] |= (uint8_t)(1 << (block & 0x07));
+  }
+  
+  return 0;
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * @file    tms99XXboot.c
+ * @brief   Fast boot for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Fast boot from a prebuilt VRAM image. One const image holds all 8
+ *          registers and the VRAM contents of the first screen, raw or run length
+ *          encoded so blank tables cost a few bytes of flash. The registers and
+ *          the image go out in one burst with the screen blanked, so no vblank
+ *          pacing, then the screen is turned on once with the image settings.
+ *          The VRAM self test can be skipped, cut to a quick address and data
+ *          line check for a warm reset, or run in full after power on.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+
+#include <tms99XXboot.h>
+
+/** SEE MY PRIVATES **/
+/*** stream the image vram contents ***/
+inline uint8_t writeBootImage(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_bootImage const * const p_image);
+
+/*** boot first screen from image ***/
+uint8_t bootTMS99XX(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_bootImage const * const p_image, uint8_t check)
+{
+  uint8_t regNum = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_image) return 0;
+  
+  setTMS99XXshadowRegs(p_tms99XX, p_image->registers);
+  
+  /**** blanked and no interrupt for the burst, transfers run at full speed with no pacing ****/
+  p_tms99XX->register1 = (uint8_t)(p_image->registers[1] & ~((1 << BLK_SCRN_BIT) | (1 << IRQ_BIT)));
+  
+  for(regNum = REGISTER_0; regNum <= REGISTER_7; regNum++)
+  {
+    setTMS99XXreg(p_tms99XX, regNum, (regNum == REGISTER_1 ? p_tms99XX->register1 : p_image->registers[regNum]));
+  }
+  
+  switch(check)
+  {
+    case BOOT_CHECK_QUICK:
+      if(!checkTMS99XXvramQuick(p_tms99XX)) return 0;
+      break;
+    case BOOT_CHECK_FULL:
+      if(!checkTMS99XXvram(p_tms99XX)) return 0;
+      break;
+    default:
+      break;
+  }
+  
+  if(!writeBootImage(p_tms99XX, p_image)) return 0;
+  
+  /**** picture on, one register write ****/
+  p_tms99XX->register1 = p_image->registers[1];
+  
+  setTMS99XXreg(p_tms99XX, REGISTER_1, p_tms99XX->register1);
+  
+  return 1;
+}
+
+/*** address and data line check ***/
+uint8_t checkTMS99XXvramQuick(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t line = 0;
+  uint8_t data = 0;
+  uint16_t vramAddr = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  /**** address 0 then each address line alone, a shorted or stuck line aliases two of them ****/
+  for(line = 0; line <= 14; line++)
+  {
+    vramAddr = (uint16_t)(line ? (1 << (line - 1)) : 0);
+    
+    /**** every data bit both ways across the set, ex. 0x01, 0xFE, 0x02, 0xFD ****/
+    data = (uint8_t)((line & 0x01) ? ~(1 << ((line >> 1) & 0x07)) : (1 << ((line >> 1) & 0x07)));
+    
+    setTMS99XXvramWriteAddr(p_tms99XX, vramAddr);
+    
+    if(!setTMS99XXvramBlock(p_tms99XX, &data, 1, VRAM_SRC_CONST)) return 0;
+  }
+  
+  for(line = 0; line <= 14; line++)
+  {
+    vramAddr = (uint16_t)(line ? (1 << (line - 1)) : 0);
+    
+    setTMS99XXvramReadAddr(p_tms99XX, vramAddr);
+    
+    /**** always the bus, a mirror over the address would hide a bad line ****/
+    if(getTMS99XXvramBusData(p_tms99XX, &data, 1) != 1) return 0;
+    
+    if(data != (uint8_t)((line & 0x01) ? ~(1 << ((line >> 1) & 0x07)) : (1 << ((line >> 1) & 0x07)))) return 0;
+  }
+  
+  /**** leave them cleared, an image that does not cover them shows nothing ****/
+  data = 0x00;
+  
+  for(line = 0; line <= 14; line++)
+  {
+    setTMS99XXvramWriteAddr(p_tms99XX, (uint16_t)(line ? (1 << (line - 1)) : 0));
+    
+    if(!setTMS99XXvramBlock(p_tms99XX, &data, 1, VRAM_SRC_CONST)) return 0;
+  }
+  
+  return 1;
+}
+
+/** SEE MY PRIVATES **/
+/*** one address setup, then raw data or decoded runs on the auto increment ***/
+inline uint8_t writeBootImage(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_bootImage const * const p_image)
+{
+  uint8_t  control = 0;
+  uint16_t index = 0;
+  uint16_t len = 0;
+  
+  setTMS99XXvramWriteAddr(p_tms99XX, p_image->vramAddr);
+  
+  if(!p_image->rle) return setTMS99XXvramBlock(p_tms99XX, p_image->p_data, p_image->size, VRAM_SRC_FLASH);
+  
+  while(index < p_image->size)
+  {
+    control = p_image->p_data[index++];
+    
+    len = (uint16_t)((control & BOOT_RLE_LEN_MASK) + 1);
+    
+    if(control & BOOT_RLE_RUN)
+    {
+      /**** run needs its data byte ****/
+      if(index >= p_image->size) return 0;
+      
+      if(!setTMS99XXvramBlock(p_tms99XX, &p_image->p_data[index++], len, VRAM_SRC_CONST)) return 0;
+    }
+    else
+    {
+      /**** literal must fit in the image ****/
+      if(len > (p_image->size - index)) return 0;
+      
+      if(!setTMS99XXvramBlock(p_tms99XX, &p_image->p_data[index], len, VRAM_SRC_FLASH)) return 0;
+      
+      index += len;
+    }
+  }
+  
+  return 1;
+}
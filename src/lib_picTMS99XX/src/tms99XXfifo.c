@@ -0,0 +1,258 @@
+/*******************************************************************************
+ * @file    tms99XXfifo.c
+ * @brief   VRAM ring buffer FIFO for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Byte FIFO held in a free region of VRAM, for buffers too big for PIC
+ *          RAM such as logs or serial receive data. Pushes collect in a small RAM
+ *          stage and go to VRAM as one batch, one address setup and the rest of
+ *          the bytes on the auto increment. Pops refill a second RAM stage the
+ *          same way. The ring wraps at the end of the region with one extra
+ *          address setup. Transfers use the library pacing, call from the main
+ *          loop, not an interrupt.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXfifo.h>
+
+/** SEE MY PRIVATES **/
+/*** move one batch between the ring and a stage, splits at the wrap ***/
+inline uint8_t transferFifoRing(struct s_tms99XX_fifo * const p_fifo, uint16_t offset, uint8_t *p_data, uint16_t size, uint8_t rnw);
+
+/*** setup empty fifo ***/
+void initTMS99XXfifo(struct s_tms99XX_fifo * const p_fifo, struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size, uint8_t *p_pushStage, uint8_t *p_popStage, uint16_t stageSize)
+{
+  /**** NULL Check ****/
+  if(!p_fifo) return;
+  
+  if(!p_tms99XX) return;
+  
+  if(!p_pushStage) return;
+  
+  if(!p_popStage) return;
+  
+  p_fifo->p_tms99XX = p_tms99XX;
+  
+  p_fifo->p_pushStage = p_pushStage;
+  
+  p_fifo->p_popStage = p_popStage;
+  
+  p_fifo->stageSize = stageSize;
+  
+  p_fifo->vramAddr = (uint16_t)(vramAddr & VRAM_ADDR_MASK);
+  
+  /**** ring stays inside vram, no wrap at 0x3FFF ****/
+  p_fifo->size = (uint16_t)((size > (MEM_SIZE - p_fifo->vramAddr)) ? (MEM_SIZE - p_fifo->vramAddr) : size);
+  
+  p_fifo->head = 0;
+  
+  p_fifo->tail = 0;
+  
+  p_fifo->vramCount = 0;
+  
+  p_fifo->pushCount = 0;
+  
+  p_fifo->popIndex = 0;
+  
+  p_fifo->popCount = 0;
+}
+
+/*** push bytes ***/
+uint16_t pushTMS99XXfifo(struct s_tms99XX_fifo * const p_fifo, void const * const p_data, uint16_t size)
+{
+  uint16_t chunk = 0;
+  uint16_t done = 0;
+  uint8_t const *p_src = (uint8_t const *)p_data;
+  
+  /**** NULL Check ****/
+  if(!p_fifo) return 0;
+  
+  if(!p_src) return 0;
+  
+  if(!p_fifo->stageSize) return 0;
+  
+  while(done < size)
+  {
+    /**** stage full, send it as one batch ****/
+    if(p_fifo->pushCount >= p_fifo->stageSize)
+    {
+      flushTMS99XXfifo(p_fifo);
+      
+      if(p_fifo->pushCount >= p_fifo->stageSize) break;
+    }
+    
+    chunk = (uint16_t)(p_fifo->stageSize - p_fifo->pushCount);
+    
+    if(chunk > (size - done)) chunk = (uint16_t)(size - done);
+    
+    memcpy(&p_fifo->p_pushStage[p_fifo->pushCount], &p_src[done], chunk);
+    
+    p_fifo->pushCount += chunk;
+    
+    done += chunk;
+  }
+  
+  return done;
+}
+
+/*** pop bytes ***/
+uint16_t popTMS99XXfifo(struct s_tms99XX_fifo * const p_fifo, void * const p_data, uint16_t size)
+{
+  uint16_t chunk = 0;
+  uint16_t done = 0;
+  uint8_t *p_dest = (uint8_t *)p_data;
+  
+  /**** NULL Check ****/
+  if(!p_fifo) return 0;
+  
+  if(!p_dest) return 0;
+  
+  if(!p_fifo->stageSize) return 0;
+  
+  while(done < size)
+  {
+    if(p_fifo->popIndex >= p_fifo->popCount)
+    {
+      p_fifo->popIndex = 0;
+      
+      p_fifo->popCount = 0;
+      
+      if(p_fifo->vramCount)
+      {
+        /**** oldest bytes are in vram, one batch from the tail ****/
+        chunk = ((p_fifo->vramCount > p_fifo->stageSize) ? p_fifo->stageSize : p_fifo->vramCount);
+        
+        if(!transferFifoRing(p_fifo, p_fifo->tail, p_fifo->p_popStage, chunk, 1)) break;
+        
+        p_fifo->tail = (uint16_t)((p_fifo->tail + chunk) % p_fifo->size);
+        
+        p_fifo->vramCount -= chunk;
+        
+        p_fifo->popCount = chunk;
+      }
+      else if(p_fifo->pushCount)
+      {
+        /**** vram empty, the push stage is next, no bus access ****/
+        memcpy(p_fifo->p_popStage, p_fifo->p_pushStage, p_fifo->pushCount);
+        
+        p_fifo->popCount = p_fifo->pushCount;
+        
+        p_fifo->pushCount = 0;
+      }
+      else
+      {
+        break;
+      }
+    }
+    
+    chunk = (uint16_t)(p_fifo->popCount - p_fifo->popIndex);
+    
+    if(chunk > (size - done)) chunk = (uint16_t)(size - done);
+    
+    memcpy(&p_dest[done], &p_fifo->p_popStage[p_fifo->popIndex], chunk);
+    
+    p_fifo->popIndex += chunk;
+    
+    done += chunk;
+  }
+  
+  return done;
+}
+
+/*** write push stage to vram ***/
+uint8_t flushTMS99XXfifo(struct s_tms99XX_fifo * const p_fifo)
+{
+  uint16_t chunk = 0;
+  
+  /**** NULL Check ****/
+  if(!p_fifo) return 0;
+  
+  if(!p_fifo->pushCount) return 1;
+  
+  /**** as much of the stage as the ring has room for ****/
+  chunk = (uint16_t)(p_fifo->size - p_fifo->vramCount);
+  
+  if(chunk > p_fifo->pushCount) chunk = p_fifo->pushCount;
+  
+  if(!chunk) return 0;
+  
+  if(!transferFifoRing(p_fifo, p_fifo->head, p_fifo->p_pushStage, chunk, 0)) return 0;
+  
+  p_fifo->head = (uint16_t)((p_fifo->head + chunk) % p_fifo->size);
+  
+  p_fifo->vramCount += chunk;
+  
+  p_fifo->pushCount -= chunk;
+  
+  memmove(p_fifo->p_pushStage, &p_fifo->p_pushStage[chunk], p_fifo->pushCount);
+  
+  return (uint8_t)(p_fifo->pushCount == 0);
+}
+
+/*** bytes in fifo ***/
+uint32_t getTMS99XXfifoCount(struct s_tms99XX_fifo const * const p_fifo)
+{
+  /**** NULL Check ****/
+  if(!p_fifo) return 0;
+  
+  return (uint32_t)p_fifo->vramCount + p_fifo->pushCount + (uint16_t)(p_fifo->popCount - p_fifo->popIndex);
+}
+
+/** SEE MY PRIVATES **/
+/*** one address setup per piece, at most two pieces ***/
+inline uint8_t transferFifoRing(struct s_tms99XX_fifo * const p_fifo, uint16_t offset, uint8_t *p_data, uint16_t size, uint8_t rnw)
+{
+  uint16_t first = (uint16_t)(p_fifo->size - offset);
+  
+  if(first > size) first = size;
+  
+  if(rnw)
+  {
+    setTMS99XXvramReadAddr(p_fifo->p_tms99XX, (uint16_t)(p_fifo->vramAddr + offset));
+  }
+  else
+  {
+    setTMS99XXvramWriteAddr(p_fifo->p_tms99XX, (uint16_t)(p_fifo->vramAddr + offset));
+  }
+  
+  if(!(rnw ? getTMS99XXvramBlock(p_fifo->p_tms99XX, p_data, first) : setTMS99XXvramBlock(p_fifo->p_tms99XX, p_data, first, VRAM_SRC_RAM))) return 0;
+  
+  if(first == size) return 1;
+  
+  /**** wrapped, rest starts at the ring base ****/
+  if(rnw)
+  {
+    setTMS99XXvramReadAddr(p_fifo->p_tms99XX, p_fifo->vramAddr);
+  }
+  else
+  {
+    setTMS99XXvramWriteAddr(p_fifo->p_tms99XX, p_fifo->vramAddr);
+  }
+  
+  return (rnw ? getTMS99XXvramBlock(p_fifo->p_tms99XX, &p_data[first], (uint16_t)(size - first)) : setTMS99XXvramBlock(p_fifo->p_tms99XX, &p_data[first], (uint16_t)(size - first), VRAM_SRC_RAM));
+}
@@ -0,0 +1,492 @@
+/*******************************************************************************
+ * @file    tms99XXgfx2.c
+ * @brief   Graphics II bitmap drawing for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details 256x192 bitmap drawing for graphics II mode. The name table
+ *          is laid out so every cell of every third has its own pattern,
+ *          cell n of the screen uses pattern n. Drawing happens on cells
+ *          cached in RAM and nothing is sent to the VDP till a commit, so
+ *          any number of primitives touching a cell cost one upload of
+ *          that cell. Commits are sent in address order so runs of
+ *          neighbouring cells share a single address setup. With shared
+ *          graphics II thirds (setTMS99XXgfx2Thirds) cells of thirds that
+ *          share a table are the same pattern, drawing one draws all.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXgfx2.h>
+
+/** SEE MY PRIVATES **/
+/*** find or load the pattern or color bytes of a cell into the cache ***/
+inline struct s_tms99XX_gfx2Cell *getGfx2Cell(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t table, uint16_t num);
+/*** fill a new cache entry without a vram read when the contents are known, 0 if the read timed out ***/
+inline uint8_t seedGfx2Cell(struct s_tms99XX_gfx2 * const p_gfx2, struct s_tms99XX_gfx2Cell * const p_cell, uint8_t table);
+/*** set bits of one pixel row of a cell ***/
+inline void setGfx2Bits(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint8_t mask, uint8_t on);
+/*** write dirty cells in address order, 0 if a transfer timed out ***/
+inline uint8_t commitGfx2Cells(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t const * const p_order);
+/*** vram address of a cell in the pattern or color table, follows third sharing ***/
+inline uint16_t getGfx2Addr(struct s_tms99XX * const p_tms99XX, uint8_t table, uint16_t num);
+
+/*** setup graphics II bitmap ***/
+uint8_t initTMS99XXgfx2(struct s_tms99XX_gfx2 * const p_gfx2, struct s_tms99XX * const p_tms99XX, uint8_t foreColor, uint8_t backColor)
+{
+  uint8_t row = 0;
+  uint8_t col = 0;
+  uint8_t third = 0;
+  uint8_t nameRow[32];
+  
+  /**** NULL Check ****/
+  if(!p_gfx2) return 0;
+  
+  if(!p_tms99XX) return 0;
+  
+  p_gfx2->p_tms99XX = p_tms99XX;
+  
+  p_gfx2->numCells = 0;
+  
+  setTMS99XXgfx2Color(p_gfx2, foreColor, backColor);
+  
+  /**** every cell is blank in the draw color till drawn ****/
+  p_gfx2->blankColor = p_gfx2->color;
+  
+  memset(p_gfx2->drawn, 0, sizeof(p_gfx2->drawn));
+  
+  if(p_tms99XX->vdpMode != GFXII_MODE)
+  {
+    setTMS99XXmode(p_tms99XX, GFXII_MODE);
+  }
+  
+  /**** each third names patterns 0 to 255 in order ****/
+  setTMS99XXvramWriteAddr(p_tms99XX, p_tms99XX->nameTableAddr);
+  
+  for(row = 0; row < 24; row++)
+  {
+    for(col = 0; col < sizeof(nameRow); col++)
+    {
+      nameRow[col] = (uint8_t)(((row & 0x07) << 5) | col);
+    }
+    
+    if(!setTMS99XXvramBlock(p_tms99XX, nameRow, sizeof(nameRow), VRAM_SRC_RAM)) return 0;
+  }
+  
+  /**** blank bitmap, only the table thirds the screen reads ****/
+  for(third = 0; third < 3; third++)
+  {
+    if(getTMS99XXgfx2Third(p_tms99XX->gfx2Thirds, LAYOUT_PATTERN, third) == third)
+    {
+      setTMS99XXvramWriteAddr(p_tms99XX, getGfx2Addr(p_tms99XX, LAYOUT_PATTERN, (uint16_t)third << 8));
+      
+      col = 0x00;
+      
+      if(!setTMS99XXvramBlock(p_tms99XX, &col, GFX2_THIRD_SIZE, VRAM_SRC_CONST)) return 0;
+    }
+    
+    if(getTMS99XXgfx2Third(p_tms99XX->gfx2Thirds, LAYOUT_COLOR, third) == third)
+    {
+      setTMS99XXvramWriteAddr(p_tms99XX, getGfx2Addr(p_tms99XX, LAYOUT_COLOR, (uint16_t)third << 8));
+      
+      if(!setTMS99XXvramBlock(p_tms99XX, &p_gfx2->color, GFX2_THIRD_SIZE, VRAM_SRC_CONST)) return 0;
+    }
+  }
+  
+  return 1;
+}
+
+/*** set draw colors ***/
+void setTMS99XXgfx2Color(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t foreColor, uint8_t backColor)
+{
+  /**** NULL Check ****/
+  if(!p_gfx2) return;
+  
+  p_gfx2->color = (uint8_t)(((foreColor & 0x0F) << 4) | (backColor & 0x0F));
+}
+
+/*** forget the blank cells ***/
+void invalidateTMS99XXgfx2(struct s_tms99XX_gfx2 * const p_gfx2)
+{
+  /**** NULL Check ****/
+  if(!p_gfx2) return;
+  
+  p_gfx2->numCells = 0;
+  
+  memset(p_gfx2->drawn, 0xFF, sizeof(p_gfx2->drawn));
+}
+
+/*** set or clear a pixel ***/
+void setTMS99XXgfx2Pixel(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint8_t on)
+{
+  /**** NULL Check ****/
+  if(!p_gfx2) return;
+  
+  if(y >= GFX2_HEIGHT) return;
+  
+  setGfx2Bits(p_gfx2, x, y, (uint8_t)(0x80 >> (x & 0x07)), on);
+}
+
+/*** horizontal span ***/
+void drawTMS99XXgfx2HSpan(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint16_t len)
+{
+  uint16_t end = 0;
+  uint16_t pos = x;
+  uint8_t  mask = 0;
+  
+  /**** NULL Check ****/
+  if(!p_gfx2) return;
+  
+  if(y >= GFX2_HEIGHT) return;
+  
+  end = (uint16_t)(x + len);
+  
+  if(end > GFX2_WIDTH) end = GFX2_WIDTH;
+  
+  /**** one mask per cell, partial masks at the ends ****/
+  while(pos < end)
+  {
+    mask = (uint8_t)(0xFF >> (pos & 0x07));
+    
+    if((pos | 0x07) >= end)
+    {
+      mask &= (uint8_t)(0xFF << (((pos | 0x07) + 1) - end));
+    }
+    
+    setGfx2Bits(p_gfx2, (uint8_t)pos, y, mask, 1);
+    
+    pos = (uint16_t)((pos | 0x07) + 1);
+  }
+}
+
+/*** vertical span ***/
+void drawTMS99XXgfx2VSpan(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint16_t len)
+{
+  uint16_t end = 0;
+  uint16_t pos = y;
+  uint8_t  mask = 0;
+  
+  /**** NULL Check ****/
+  if(!p_gfx2) return;
+  
+  end = (uint16_t)(y + len);
+  
+  if(end > GFX2_HEIGHT) end = GFX2_HEIGHT;
+  
+  mask = (uint8_t)(0x80 >> (x & 0x07));
+  
+  for(; pos < end; pos++)
+  {
+    setGfx2Bits(p_gfx2, x, (uint8_t)pos, mask, 1);
+  }
+}
+
+/*** bresenham line ***/
+void drawTMS99XXgfx2Line(struct s_tms99XX_gfx2 * const p_gfx2, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  int16_t dx = 0;
+  int16_t dy = 0;
+  int16_t sx = 0;
+  int16_t sy = 0;
+  int16_t err = 0;
+  int16_t err2 = 0;
+  
+  /**** NULL Check ****/
+  if(!p_gfx2) return;
+  
+  /**** straight lines use the faster span methods ****/
+  if((y0 == y1) && (y0 >= 0) && (y0 < GFX2_HEIGHT))
+  {
+    if(x0 > x1)
+    {
+      dx = x0;
+      x0 = x1;
+      x1 = dx;
+    }
+    
+    if(x0 < 0) x0 = 0;
+    
+    if((x1 >= 0) && (x0 < GFX2_WIDTH))
+    {
+      drawTMS99XXgfx2HSpan(p_gfx2, (uint8_t)x0, (uint8_t)y0, (uint16_t)(x1 - x0 + 1));
+    }
+    
+    return;
+  }
+  
+  dx = (int16_t)(x1 > x0 ? x1 - x0 : x0 - x1);
+  
+  dy = (int16_t)-(y1 > y0 ? y1 - y0 : y0 - y1);
+  
+  sx = (int16_t)(x0 < x1 ? 1 : -1);
+  
+  sy = (int16_t)(y0 < y1 ? 1 : -1);
+  
+  err = (int16_t)(dx + dy);
+  
+  for(;;)
+  {
+    if((x0 >= 0) && (x0 < GFX2_WIDTH) && (y0 >= 0) && (y0 < GFX2_HEIGHT))
+    {
+      setGfx2Bits(p_gfx2, (uint8_t)x0, (uint8_t)y0, (uint8_t)(0x80 >> (x0 & 0x07)), 1);
+    }
+    
+    if((x0 == x1) && (y0 == y1)) break;
+    
+    err2 = (int16_t)(2 * err);
+    
+    if(err2 >= dy)
+    {
+      err = (int16_t)(err + dy);
+      
+      x0 = (int16_t)(x0 + sx);
+    }
+    
+    if(err2 <= dx)
+    {
+      err = (int16_t)(err + dx);
+      
+      y0 = (int16_t)(y0 + sy);
+    }
+  }
+}
+
+/*** rectangle outline ***/
+void drawTMS99XXgfx2Rect(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint16_t width, uint16_t height)
+{
+  /**** NULL Check ****/
+  if(!p_gfx2) return;
+  
+  if(!width || !height) return;
+  
+  drawTMS99XXgfx2HSpan(p_gfx2, x, y, width);
+  
+  if((y + height - 1) < GFX2_HEIGHT)
+  {
+    drawTMS99XXgfx2HSpan(p_gfx2, x, (uint8_t)(y + height - 1), width);
+  }
+  
+  drawTMS99XXgfx2VSpan(p_gfx2, x, y, height);
+  
+  if((x + width - 1) < GFX2_WIDTH)
+  {
+    drawTMS99XXgfx2VSpan(p_gfx2, (uint8_t)(x + width - 1), y, height);
+  }
+}
+
+/*** filled rectangle ***/
+void fillTMS99XXgfx2Rect(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint16_t width, uint16_t height)
+{
+  uint16_t row = y;
+  uint16_t end = 0;
+  
+  /**** NULL Check ****/
+  if(!p_gfx2) return;
+  
+  end = (uint16_t)(y + height);
+  
+  if(end > GFX2_HEIGHT) end = GFX2_HEIGHT;
+  
+  for(; row < end; row++)
+  {
+    drawTMS99XXgfx2HSpan(p_gfx2, x, (uint8_t)row, width);
+  }
+}
+
+/*** write dirty cells ***/
+uint8_t commitTMS99XXgfx2(struct s_tms99XX_gfx2 * const p_gfx2)
+{
+  uint8_t index = 0;
+  uint8_t sortIndex = 0;
+  uint8_t temp = 0;
+  uint8_t order[GFX2_CACHE_CELLS];
+  
+  /**** NULL Check ****/
+  if(!p_gfx2) return 0;
+  
+  /**** insertion sort cache slots by vram address ****/
+  for(index = 0; index < p_gfx2->numCells; index++)
+  {
+    temp = index;
+    
+    for(sortIndex = index; (sortIndex > 0) && (p_gfx2->cells[order[sortIndex - 1]].vramAddr > p_gfx2->cells[temp].vramAddr); sortIndex--)
+    {
+      order[sortIndex] = order[sortIndex - 1];
+    }
+    
+    order[sortIndex] = temp;
+  }
+  
+  return commitGfx2Cells(p_gfx2, order);
+}
+
+/** SEE MY PRIVATES **/
+/*** find or load a cell, keyed by the address the screen cell reads so shared thirds share entries ***/
+inline struct s_tms99XX_gfx2Cell *getGfx2Cell(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t table, uint16_t num)
+{
+  uint8_t  index = 0;
+  uint16_t vramAddr = getGfx2Addr(p_gfx2->p_tms99XX, table, num);
+  
+  struct s_tms99XX_gfx2Cell *p_cell = NULL;
+  
+  for(index = 0; index < p_gfx2->numCells; index++)
+  {
+    if(p_gfx2->cells[index].vramAddr == vramAddr) return &p_gfx2->cells[index];
+  }
+  
+  /**** cache full, commit everything and start over. dirty cells that did not go out stay ****/
+  if(p_gfx2->numCells >= GFX2_CACHE_CELLS)
+  {
+    if(!commitTMS99XXgfx2(p_gfx2)) return NULL;
+    
+    p_gfx2->numCells = 0;
+  }
+  
+  p_cell = &p_gfx2->cells[p_gfx2->numCells];
+  
+  p_cell->vramAddr = vramAddr;
+  
+  p_cell->dirty = 0;
+  
+  /**** a cell that could not be read is not cached ****/
+  if(!seedGfx2Cell(p_gfx2, p_cell, table)) return NULL;
+  
+  p_gfx2->numCells++;
+  
+  return p_cell;
+}
+
+/*** seed from the blank state, else read it, mirrors serve the read from RAM ***/
+inline uint8_t seedGfx2Cell(struct s_tms99XX_gfx2 * const p_gfx2, struct s_tms99XX_gfx2Cell * const p_cell, uint8_t table)
+{
+  uint16_t index = (uint16_t)((p_cell->vramAddr & 0x1FFF) >> 3);
+  
+  /**** never committed since init, still what init wrote. pattern and color share a bit, a shared bit only costs a read ****/
+  if(!((p_gfx2->drawn[index >> 3] >> (index & 0x07)) & 0x01))
+  {
+    memset(p_cell->data, (table == LAYOUT_COLOR ? p_gfx2->blankColor : 0x00), sizeof(p_cell->data));
+    
+    return 1;
+  }
+  
+  /**** read modify write, fetch current cell contents ****/
+  setTMS99XXvramReadAddr(p_gfx2->p_tms99XX, p_cell->vramAddr);
+  
+  return getTMS99XXvramBlock(p_gfx2->p_tms99XX, p_cell->data, sizeof(p_cell->data));
+}
+
+/*** set bits of a cell row ***/
+inline void setGfx2Bits(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint8_t mask, uint8_t on)
+{
+  uint8_t  pattern = 0;
+  uint16_t num = (uint16_t)(((uint16_t)(y >> 3) << 5) | (x >> 3));
+  
+  struct s_tms99XX_gfx2Cell *p_cell = NULL;
+  
+  p_cell = getGfx2Cell(p_gfx2, LAYOUT_PATTERN, num);
+  
+  if(!p_cell) return;
+  
+  pattern = (uint8_t)(on ? (p_cell->data[y & 0x07] | mask) : (p_cell->data[y & 0x07] & ~mask));
+  
+  if(pattern != p_cell->data[y & 0x07])
+  {
+    p_cell->data[y & 0x07] = pattern;
+    
+    p_cell->dirty = 1;
+  }
+  
+  /**** only set pixels take the draw color ****/
+  if(!on) return;
+  
+  p_cell = getGfx2Cell(p_gfx2, LAYOUT_COLOR, num);
+  
+  if(!p_cell) return;
+  
+  if(p_cell->data[y & 0x07] != p_gfx2->color)
+  {
+    p_cell->data[y & 0x07] = p_gfx2->color;
+    
+    p_cell->dirty = 1;
+  }
+}
+
+/*** write cells, runs of neighbouring addresses go out in one transfer ***/
+inline uint8_t commitGfx2Cells(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t const * const p_order)
+{
+  uint8_t  index = 0;
+  uint8_t  runLen = 0;
+  uint16_t runStart = 0;
+  uint8_t  buffer[GFX2_CACHE_CELLS * 8];
+  
+  struct s_tms99XX_gfx2Cell *p_cell = NULL;
+  
+  for(index = 0; index <= p_gfx2->numCells; index++)
+  {
+    p_cell = (index < p_gfx2->numCells ? &p_gfx2->cells[p_order[index]] : NULL);
+    
+    /**** run ends on the last cell, a clean cell or a gap in addresses ****/
+    if(runLen && (!p_cell || !p_cell->dirty || (p_cell->vramAddr != (uint16_t)(runStart + ((uint16_t)runLen << 3)))))
+    {
+      setTMS99XXvramWriteAddr(p_gfx2->p_tms99XX, runStart);
+      
+      if(!setTMS99XXvramBlock(p_gfx2->p_tms99XX, buffer, (uint16_t)((uint16_t)runLen << 3), VRAM_SRC_RAM))
+      {
+        /**** the run is the cells just before this one, keep them for the next commit ****/
+        for(; runLen; runLen--)
+        {
+          p_gfx2->cells[p_order[index - runLen]].dirty = 1;
+        }
+        
+        return 0;
+      }
+      
+      runLen = 0;
+    }
+    
+    if(!p_cell || !p_cell->dirty) continue;
+    
+    if(!runLen) runStart = p_cell->vramAddr;
+    
+    memcpy(&buffer[runLen << 3], p_cell->data, sizeof(p_cell->data));
+    
+    runLen++;
+    
+    p_cell->dirty = 0;
+    
+    p_gfx2->drawn[(p_cell->vramAddr & 0x1FFF) >> 6] |= (uint8_t)(1 << ((p_cell->vramAddr >> 3) & 0x07));
+  }
+  
+  return 1;
+}
+
+/*** cell address, cell n of a third is entry n of the table third it reads ***/
+inline uint16_t getGfx2Addr(struct s_tms99XX * const p_tms99XX, uint8_t table, uint16_t num)
+{
+  uint16_t tableAddr = (table == LAYOUT_COLOR ? p_tms99XX->colorTableAddr : p_tms99XX->patternTableAddr);
+  
+  return (uint16_t)((tableAddr & 0x2000) + (getTMS99XXgfx2Third(p_tms99XX->gfx2Thirds, table, (uint8_t)(num >> 8)) * GFX2_THIRD_SIZE) + ((num & 0xFF) << 3));
+}
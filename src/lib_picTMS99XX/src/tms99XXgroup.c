@@ -0,0 +1,309 @@
+/*******************************************************************************
+ * @file    tms99XXgroup.c
+ * @brief   Multiple VDP groups for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Several VDPs on one data bus and mode line with their own
+ *          chip selects, ex. an overlay VDP on EXTVID. Pulsing every nCSW
+ *          together writes the same data to all chips in one transfer,
+ *          register setup and fonts cost one transfer instead of one per
+ *          chip. Reads are never broadcast. Per chip access still works
+ *          through each chip's own struct. Resetting the group releases
+ *          every nreset at once so chips on a common clock start their
+ *          frames together, the master's nINT paces all broadcasts.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXgroup.h>
+
+/** SEE MY PRIVATES **/
+/*** read every chip's status, broadcasts only read the master's ***/
+inline void readGroupStatus(struct s_tms99XX_group * const p_group);
+/*** start the software state of a chip that only had its port set ***/
+inline void initGroupChip(struct s_tms99XX_group * const p_group, struct s_tms99XX * const p_chip);
+
+/*** start a group ***/
+void initTMS99XXgroup(struct s_tms99XX_group * const p_group, struct s_tms99XX * const p_master)
+{
+  /**** NULL Check ****/
+  if(!p_group) return;
+  
+  if(!p_master) return;
+  
+  p_group->p_chips[0] = p_master;
+  
+  p_group->numChips = 1;
+  
+  /**** broadcast uses the master's ports, registers, status read and nINT ****/
+  memcpy(&p_group->broadcast, p_master, sizeof(p_group->broadcast));
+  
+  /**** the master's RAM side buffers describe its vram alone, broadcasts write every chip ****/
+  p_group->broadcast.p_mirrors = NULL;
+  
+  p_group->broadcast.p_uploadCache = NULL;
+  
+  p_group->broadcast.p_combine = NULL;
+}
+
+/*** add a chip ***/
+uint8_t addTMS99XXgroupChip(struct s_tms99XX_group * const p_group, struct s_tms99XX * const p_chip)
+{
+  /**** NULL Check ****/
+  if(!p_group) return 0;
+  
+  if(!p_chip) return 0;
+  
+  if(p_group->numChips >= GROUP_MAX_CHIPS) return 0;
+  
+  /**** one strobe can only hit pins of the same port ****/
+  if(p_chip->p_dataTRIS != p_group->broadcast.p_dataTRIS) return 0;
+  
+  if(p_chip->modeMask != p_group->broadcast.modeMask) return 0;
+  
+  p_chip->p_dataPortW = p_group->broadcast.p_dataPortW;
+  
+  p_chip->p_dataPortR = p_group->broadcast.p_dataPortR;
+  
+  p_chip->p_ctrlPortW = p_group->broadcast.p_ctrlPortW;
+  
+  if(!p_chip->p_intPortR) p_chip->p_intPortR = p_group->broadcast.p_intPortR;
+  
+  p_group->broadcast.nCSWmask |= p_chip->nCSWmask;
+  
+  p_group->broadcast.nresetMask |= p_chip->nresetMask;
+  
+  initGroupChip(p_group, p_chip);
+  
+  p_group->p_chips[p_group->numChips++] = p_chip;
+  
+  return 1;
+}
+
+/*** reset all chips together ***/
+void resetTMS99XXgroup(struct s_tms99XX_group * const p_group, uint8_t vdpMode, uint8_t backColor)
+{
+  uint8_t index = 0;
+  
+  struct s_tms99XX *p_chip = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_group) return;
+  
+  /**** pulses every nreset, then broadcasts the mode registers ****/
+  initTMS99XX(&p_group->broadcast, vdpMode, backColor, p_group->broadcast.p_dataPortW, p_group->broadcast.p_dataPortR, p_group->broadcast.p_ctrlPortW, p_group->broadcast.p_intPortR);
+  
+  for(index = 0; index < p_group->numChips; index++)
+  {
+    p_chip = p_group->p_chips[index];
+    
+    p_chip->vdpMode = p_group->broadcast.vdpMode;
+    
+    p_chip->register0 = p_group->broadcast.register0;
+    
+    p_chip->register1 = p_group->broadcast.register1;
+    
+    p_chip->colorReg = p_group->broadcast.colorReg;
+    
+    p_chip->nameTableAddr = p_group->broadcast.nameTableAddr;
+    
+    p_chip->colorTableAddr = p_group->broadcast.colorTableAddr;
+    
+    p_chip->patternTableAddr = p_group->broadcast.patternTableAddr;
+    
+    p_chip->spriteAttributeAddr = p_group->broadcast.spriteAttributeAddr;
+    
+    p_chip->spritePatternAddr = p_group->broadcast.spritePatternAddr;
+    
+    p_chip->gfx2Thirds = p_group->broadcast.gfx2Thirds;
+    
+    p_chip->statusLatch = 0;
+    
+    /**** reset and mode setup went through the broadcast, nothing cached is right anymore ****/
+    invalidateTMS99XXvramMirrors(p_chip);
+    
+    invalidateTMS99XXuploadCache(p_chip);
+    
+    p_chip->vramAddrState = VRAM_ADDR_UNKNOWN;
+  }
+}
+
+/*** broadcast a register ***/
+void setTMS99XXgroupReg(struct s_tms99XX_group * const p_group, uint8_t regNum, uint8_t regData)
+{
+  uint8_t index = 0;
+  
+  /**** NULL Check ****/
+  if(!p_group) return;
+  
+  setTMS99XXreg(&p_group->broadcast, regNum, regData);
+  
+  /**** broadcast pacing follows register 1 so keep it in step too ****/
+  setTMS99XXshadowReg(&p_group->broadcast, regNum, regData);
+  
+  for(index = 0; index < p_group->numChips; index++)
+  {
+    setTMS99XXshadowReg(p_group->p_chips[index], regNum, regData);
+  }
+}
+
+/*** broadcast vram data ***/
+int setTMS99XXgroupVramData(struct s_tms99XX_group * const p_group, uint16_t vramAddr, void const * const p_data, int size)
+{
+  uint8_t index = 0;
+  int amtWrote = 0;
+  int total = 0;
+  uint8_t const *p_src = (uint8_t const *)p_data;
+  
+  /**** NULL Check ****/
+  if(!p_group) return 0;
+  
+  if(!p_data) return 0;
+  
+  if(size <= 0) return 0;
+  
+  /**** combined bytes still owed to a chip would land after the broadcast and undo it ****/
+  for(index = 0; index < p_group->numChips; index++)
+  {
+    if(!flushTMS99XXcombine(p_group->p_chips[index])) return 0;
+  }
+  
+  setTMS99XXvramWriteAddr(&p_group->broadcast, vramAddr);
+  
+  for(; total < size; total += amtWrote)
+  {
+    amtWrote = setTMS99XXvramData(&p_group->broadcast, p_src, size - total);
+    
+    /**** transfer only cleared the master's interrupt ****/
+    readGroupStatus(p_group);
+    
+    if(!amtWrote) break;
+    
+    p_src += amtWrote;
+  }
+  
+  /**** every chip got the bytes, none of their structs saw them ****/
+  for(index = 0; index < p_group->numChips; index++)
+  {
+    invalidateTMS99XXvramRange(p_group->p_chips[index], vramAddr, (uint16_t)size);
+  }
+  
+  return (total < size ? 0 : total);
+}
+
+/*** wait for the group vertical blank ***/
+void waitTMS99XXgroupVblank(struct s_tms99XX_group * const p_group)
+{
+  /**** NULL Check ****/
+  if(!p_group) return;
+  
+  waitTMS99XXvblank(&p_group->broadcast);
+  
+  readGroupStatus(p_group);
+}
+
+/** SEE MY PRIVATES **/
+/*** read status of the other chips ***/
+inline void readGroupStatus(struct s_tms99XX_group * const p_group)
+{
+  uint8_t index = 0;
+  
+  /**** keep the master's latched bits in its own struct ****/
+  p_group->p_chips[0]->statusLatch |= getTMS99XXstatusLatch(&p_group->broadcast);
+  
+  for(index = 1; index < p_group->numChips; index++)
+  {
+    getTMS99XXstatus(p_group->p_chips[index]);
+  }
+}
+
+/*** registers and tables follow the group, timing follows the master ***/
+inline void initGroupChip(struct s_tms99XX_group * const p_group, struct s_tms99XX * const p_chip)
+{
+  p_chip->vdpMode = p_group->broadcast.vdpMode;
+  
+  p_chip->register0 = p_group->broadcast.register0;
+  
+  p_chip->register1 = p_group->broadcast.register1;
+  
+  p_chip->colorReg = p_group->broadcast.colorReg;
+  
+  p_chip->nameTableAddr = p_group->broadcast.nameTableAddr;
+  
+  p_chip->colorTableAddr = p_group->broadcast.colorTableAddr;
+  
+  p_chip->patternTableAddr = p_group->broadcast.patternTableAddr;
+  
+  p_chip->spriteAttributeAddr = p_group->broadcast.spriteAttributeAddr;
+  
+  p_chip->spritePatternAddr = p_group->broadcast.spritePatternAddr;
+  
+  p_chip->gfx2Thirds = p_group->broadcast.gfx2Thirds;
+  
+  p_chip->statusLatch = 0;
+  
+  p_chip->vblankFlag = 0;
+  
+  p_chip->vblankMode = p_group->broadcast.vblankMode;
+  
+  p_chip->vblankTimeout = p_group->broadcast.vblankTimeout;
+  
+  p_chip->p_vblankYield = p_group->broadcast.p_vblankYield;
+  
+  p_chip->p_timerL = p_group->broadcast.p_timerL;
+  
+  p_chip->p_timerH = p_group->broadcast.p_timerH;
+  
+  p_chip->timerTicksPerMs = p_group->broadcast.timerTicksPerMs;
+  
+  p_chip->framePeriod = p_group->broadcast.framePeriod;
+  
+  p_chip->blankWindow = p_group->broadcast.blankWindow;
+  
+  p_chip->vblankStamp = p_group->broadcast.vblankStamp;
+  
+  p_chip->videoStandard = p_group->broadcast.videoStandard;
+  
+  /**** no address set yet, nothing cached, bus state read on first use ****/
+  p_chip->vramAddr = 0;
+  
+  p_chip->vramAddrState = VRAM_ADDR_UNKNOWN;
+  
+  p_chip->vramAddrRead = 0;
+  
+  p_chip->p_mirrors = NULL;
+  
+  p_chip->p_uploadCache = NULL;
+  
+  p_chip->p_combine = NULL;
+  
+  p_chip->ctrlShadow = *p_chip->p_ctrlPortW;
+  
+  p_chip->modeLevel = BUS_UNKNOWN;
+  
+  p_chip->busDir = BUS_UNKNOWN;
+}
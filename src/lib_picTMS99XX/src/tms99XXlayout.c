@@ -0,0 +1,279 @@
+/*******************************************************************************
+ * @file    tms99XXlayout.c
+ * @brief   VRAM layout planner for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details VRAM layout planner. Given a mode and the tables wanted,
+ *          including extra banks of a table for double buffering or
+ *          animation, places every table on its register alignment
+ *          without overlap and reports the VRAM left free. Graphics II
+ *          pattern and color tables can only sit at 0x0000 or 0x2000.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXlayout.h>
+
+/** SEE MY PRIVATES **/
+/*** default size of a table in a mode, 0 if not used ***/
+inline uint16_t getLayoutSize(uint8_t vdpMode, uint8_t table);
+/*** check if a range of 64 byte units is free ***/
+inline uint8_t checkLayoutFree(uint8_t const * const p_used, uint16_t unit, uint16_t numUnits);
+/*** check if a unit of a table is read by the screen, graphics II thirds can go unread ***/
+inline uint8_t checkLayoutRead(struct s_tms99XX_layout const * const p_layout, uint8_t table, uint16_t unitOffset);
+
+/*** setup layout request ***/
+void initTMS99XXlayout(struct s_tms99XX_layout * const p_layout, uint8_t vdpMode)
+{
+  uint8_t table = 0;
+  
+  /**** NULL Check ****/
+  if(!p_layout) return;
+  
+  p_layout->vdpMode = vdpMode;
+  
+  p_layout->gfx2Thirds = GFX2_THIRDS_FULL;
+  
+  p_layout->numFree = 0;
+  
+  for(table = 0; table < LAYOUT_TABLES; table++)
+  {
+    p_layout->size[table] = getLayoutSize(vdpMode, table);
+    
+    p_layout->numBanks[table] = (uint8_t)(p_layout->size[table] ? 1 : 0);
+    
+    memset(p_layout->addr[table], 0xFF, sizeof(p_layout->addr[table]));
+  }
+}
+
+/*** size graphics II tables for third sharing ***/
+void setTMS99XXlayoutThirds(struct s_tms99XX_layout * const p_layout, uint8_t gfx2Thirds)
+{
+  uint8_t table = 0;
+  uint8_t third = 0;
+  uint8_t last = 0;
+  
+  /**** NULL Check ****/
+  if(!p_layout) return;
+  
+  p_layout->gfx2Thirds = gfx2Thirds;
+  
+  if(p_layout->vdpMode != GFXII_MODE) return;
+  
+  /**** table runs to the end of the last third any screen third reads ****/
+  for(table = LAYOUT_COLOR; table <= LAYOUT_PATTERN; table++)
+  {
+    last = 0;
+    
+    for(third = 0; third < 3; third++)
+    {
+      if(getTMS99XXgfx2Third(gfx2Thirds, table, third) > last) last = getTMS99XXgfx2Third(gfx2Thirds, table, third);
+    }
+    
+    p_layout->size[table] = (uint16_t)((last + 1) * GFX2_THIRD_SIZE);
+  }
+}
+
+/*** place all tables ***/
+uint8_t planTMS99XXlayout(struct s_tms99XX_layout * const p_layout)
+{
+  uint8_t  table = 0;
+  uint8_t  bank = 0;
+  uint8_t  placed = 1;
+  uint16_t align = 0;
+  uint16_t unit = 0;
+  uint16_t numUnits = 0;
+  uint16_t index = 0;
+  uint8_t  used[(MEM_SIZE >> LAYOUT_UNIT_SHIFT) / 8];
+  
+  /**** NULL Check ****/
+  if(!p_layout) return 0;
+  
+  memset(used, 0, sizeof(used));
+  
+  /**** biggest alignment first, 0x2000 down to 0x40, keeps small tables out of big holes ****/
+  for(align = 0x2000; align >= (1 << LAYOUT_UNIT_SHIFT); align >>= 1)
+  {
+    for(table = 0; table < LAYOUT_TABLES; table++)
+    {
+      if(getTMS99XXlayoutAlign(p_layout->vdpMode, table) != align) continue;
+      
+      numUnits = (uint16_t)((p_layout->size[table] + (1 << LAYOUT_UNIT_SHIFT) - 1) >> LAYOUT_UNIT_SHIFT);
+      
+      for(bank = 0; bank < LAYOUT_MAX_BANKS; bank++)
+      {
+        p_layout->addr[table][bank] = LAYOUT_NO_ADDR;
+        
+        if((bank >= p_layout->numBanks[table]) || !numUnits) continue;
+        
+        /**** first fit on the table alignment ****/
+        for(unit = 0; (unit + numUnits) <= (MEM_SIZE >> LAYOUT_UNIT_SHIFT); unit += (align >> LAYOUT_UNIT_SHIFT))
+        {
+          if(checkLayoutFree(used, unit, numUnits)) break;
+        }
+        
+        if((unit + numUnits) > (MEM_SIZE >> LAYOUT_UNIT_SHIFT))
+        {
+          placed = 0;
+          
+          continue;
+        }
+        
+        p_layout->addr[table][bank] = (uint16_t)(unit << LAYOUT_UNIT_SHIFT);
+        
+        for(index = unit; index < (unit + numUnits); index++)
+        {
+          if(!checkLayoutRead(p_layout, table, (uint16_t)(index - unit))) continue;
+          
+          used[index >> 3] |= (uint8_t)(1 << (index & 0x07));
+        }
+      }
+    }
+  }
+  
+  /**** collect runs of unused units ****/
+  p_layout->numFree = 0;
+  
+  for(index = 0; index < (MEM_SIZE >> LAYOUT_UNIT_SHIFT); index++)
+  {
+    if((used[index >> 3] >> (index & 0x07)) & 0x01) continue;
+    
+    if((index > 0) && !((used[(index - 1) >> 3] >> ((index - 1) & 0x07)) & 0x01) && p_layout->numFree)
+    {
+      p_layout->freeRegions[p_layout->numFree - 1].size += (1 << LAYOUT_UNIT_SHIFT);
+      
+      continue;
+    }
+    
+    if(p_layout->numFree >= LAYOUT_MAX_FREE) break;
+    
+    p_layout->freeRegions[p_layout->numFree].addr = (uint16_t)(index << LAYOUT_UNIT_SHIFT);
+    
+    p_layout->freeRegions[p_layout->numFree].size = (1 << LAYOUT_UNIT_SHIFT);
+    
+    p_layout->numFree++;
+  }
+  
+  return placed;
+}
+
+/*** apply bank 0 of a layout ***/
+void applyTMS99XXlayout(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_layout const * const p_layout)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+  
+  if(!p_layout) return;
+  
+  if(p_layout->addr[LAYOUT_NAME][0] != LAYOUT_NO_ADDR) p_tms99XX->nameTableAddr = p_layout->addr[LAYOUT_NAME][0];
+  
+  if(p_layout->addr[LAYOUT_COLOR][0] != LAYOUT_NO_ADDR) p_tms99XX->colorTableAddr = p_layout->addr[LAYOUT_COLOR][0];
+  
+  if(p_layout->addr[LAYOUT_PATTERN][0] != LAYOUT_NO_ADDR) p_tms99XX->patternTableAddr = p_layout->addr[LAYOUT_PATTERN][0];
+  
+  if(p_layout->addr[LAYOUT_SPRITE_ATTRIBUTE][0] != LAYOUT_NO_ADDR) p_tms99XX->spriteAttributeAddr = p_layout->addr[LAYOUT_SPRITE_ATTRIBUTE][0];
+  
+  if(p_layout->addr[LAYOUT_SPRITE_PATTERN][0] != LAYOUT_NO_ADDR) p_tms99XX->spritePatternAddr = p_layout->addr[LAYOUT_SPRITE_PATTERN][0];
+  
+  p_tms99XX->gfx2Thirds = p_layout->gfx2Thirds;
+  
+  /**** writes registers 0 to 7 from the struct ****/
+  setTMS99XXmode(p_tms99XX, p_layout->vdpMode);
+}
+
+/*** table alignment ***/
+uint16_t getTMS99XXlayoutAlign(uint8_t vdpMode, uint8_t table)
+{
+  switch(table)
+  {
+    case LAYOUT_NAME:
+      return (1 << NAME_TABLE_ADDR_SCALE);
+    case LAYOUT_COLOR:
+      /**** graphics II color table is 0x0000 or 0x2000 only ****/
+      return (vdpMode == GFXII_MODE ? 0x2000 : (1 << COLOR_TABLE_ADDR_SCALE));
+    case LAYOUT_PATTERN:
+      /**** graphics II pattern table is 0x0000 or 0x2000 only ****/
+      return (vdpMode == GFXII_MODE ? 0x2000 : (1 << PATTERN_TABLE_ADDR_SCALE));
+    case LAYOUT_SPRITE_ATTRIBUTE:
+      return (1 << SPRITE_ATTRIBUTE_TABLE_ADDR_SCALE);
+    case LAYOUT_SPRITE_PATTERN:
+      return (1 << SPRITE_PATTERN_TABLE_ADDR_SCALE);
+    default:
+      return 0;
+  }
+}
+
+/** SEE MY PRIVATES **/
+/*** default table size ***/
+inline uint16_t getLayoutSize(uint8_t vdpMode, uint8_t table)
+{
+  switch(table)
+  {
+    case LAYOUT_NAME:
+      return (vdpMode == TXT_MODE ? TXT_NAME_TABLE_SIZE : NAME_TABLE_SIZE);
+    case LAYOUT_COLOR:
+      if(vdpMode == GFXI_MODE) return 32;
+      return (vdpMode == GFXII_MODE ? GFX2_TABLE_SIZE : 0);
+    case LAYOUT_PATTERN:
+      if(vdpMode == GFXII_MODE) return GFX2_TABLE_SIZE;
+      return (vdpMode == BMP_MODE ? BMP_FRAME_SIZE : 2048);
+    case LAYOUT_SPRITE_ATTRIBUTE:
+      return (vdpMode == TXT_MODE ? 0 : SPRITE_ATTRIBUTE_TABLE_SIZE);
+    case LAYOUT_SPRITE_PATTERN:
+      return (vdpMode == TXT_MODE ? 0 : 2048);
+    default:
+      return 0;
+  }
+}
+
+/*** check free units ***/
+inline uint8_t checkLayoutFree(uint8_t const * const p_used, uint16_t unit, uint16_t numUnits)
+{
+  uint16_t index = 0;
+  
+  for(index = unit; index < (unit + numUnits); index++)
+  {
+    if((p_used[index >> 3] >> (index & 0x07)) & 0x01) return 0;
+  }
+  
+  return 1;
+}
+
+/*** check unit is read, a graphics II table third no screen third maps to stays free ***/
+inline uint8_t checkLayoutRead(struct s_tms99XX_layout const * const p_layout, uint8_t table, uint16_t unitOffset)
+{
+  uint8_t third = 0;
+  
+  if(p_layout->vdpMode != GFXII_MODE) return 1;
+  
+  if((table != LAYOUT_COLOR) && (table != LAYOUT_PATTERN)) return 1;
+  
+  third = (uint8_t)((unitOffset << LAYOUT_UNIT_SHIFT) / GFX2_THIRD_SIZE);
+  
+  /**** sharing masks only clear third bits, a third is read iff it maps to itself ****/
+  return (uint8_t)(getTMS99XXgfx2Third(p_layout->gfx2Thirds, table, third) == third);
+}
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * @file    tms99XXlist.c
+ * @brief   Display list interpreter for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Display lists, screens and effects as data. A list is a short
+ *          bytecode in program memory, set address, copy inline bytes, copy an
+ *          asset, fill, set register, repeat, wait for vblank and end, run by one
+ *          interpreter loop instead of a chain of calls per screen. Copies and
+ *          fills follow each other on the auto increment with no new address
+ *          setup. Each op is still its own paced transfer, with its own di/ei,
+ *          vblank wait and status read, the bus is not held in write mode
+ *          from one op to the next. Lists can be written in C with the LIST_
+ *          macros or compiled from text with tools/tms99XXlistc.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+
+#include <tms99XXlist.h>
+
+/*** run display list ***/
+uint8_t runTMS99XXlist(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_list, struct s_tms99XX_asset const * const p_assets, uint8_t numAssets)
+{
+  uint8_t  depth = 0;
+  uint16_t pc = 0;
+  uint16_t len = 0;
+  uint16_t loopStart[LIST_MAX_DEPTH];
+  uint8_t  loopCount[LIST_MAX_DEPTH];
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_list) return 0;
+  
+  for(;;)
+  {
+    switch(p_list[pc++])
+    {
+      case LIST_OP_END:
+        return 1;
+      case LIST_OP_ADDR:
+        setTMS99XXvramWriteAddr(p_tms99XX, (uint16_t)(((uint16_t)p_list[pc] << 8) | p_list[pc + 1]));
+        
+        pc += 2;
+        break;
+      case LIST_OP_COPY:
+        len = (uint16_t)(((uint16_t)p_list[pc] << 8) | p_list[pc + 1]);
+        
+        /**** data is inline, straight from the list ****/
+        if(!setTMS99XXvramBlock(p_tms99XX, &p_list[pc + 2], len, VRAM_SRC_FLASH)) return 0;
+        
+        pc += (uint16_t)(2 + len);
+        break;
+      case LIST_OP_FILL:
+        len = (uint16_t)(((uint16_t)p_list[pc] << 8) | p_list[pc + 1]);
+        
+        if(!setTMS99XXvramBlock(p_tms99XX, &p_list[pc + 2], len, VRAM_SRC_CONST)) return 0;
+        
+        pc += 3;
+        break;
+      case LIST_OP_REG:
+        setTMS99XXshadowReg(p_tms99XX, p_list[pc], p_list[pc + 1]);
+        
+        setTMS99XXreg(p_tms99XX, p_list[pc], p_list[pc + 1]);
+        
+        pc += 2;
+        break;
+      case LIST_OP_REPEAT:
+        if((depth >= LIST_MAX_DEPTH) || !p_list[pc]) return 0;
+        
+        loopCount[depth] = p_list[pc++];
+        
+        loopStart[depth++] = pc;
+        break;
+      case LIST_OP_LOOP:
+        if(!depth) return 0;
+        
+        /**** back to the top till the count runs out ****/
+        if(--loopCount[depth - 1])
+        {
+          pc = loopStart[depth - 1];
+        }
+        else
+        {
+          depth--;
+        }
+        break;
+      case LIST_OP_VBLANK:
+        if(!waitTMS99XXvblank(p_tms99XX)) return 0;
+        break;
+      case LIST_OP_ASSET:
+        if(!p_assets || (p_list[pc] >= numAssets)) return 0;
+        
+        if(!setTMS99XXvramBlock(p_tms99XX, p_assets[p_list[pc]].p_data, p_assets[p_list[pc]].size, VRAM_SRC_FLASH)) return 0;
+        
+        pc++;
+        break;
+      default:
+        return 0;
+    }
+  }
+}
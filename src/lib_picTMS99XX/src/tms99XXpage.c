@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * @file    tms99XXpage.c
+ * @brief   Page flipping for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Double buffered name and sprite attribute tables. Registers
+ *          2 and 5 can point at any aligned block of VRAM, so showing the
+ *          other page is two register writes at vertical blank instead of
+ *          a copy. The application draws into the back page over as many
+ *          frames as it needs, flips, and can then bring the new back page
+ *          up to date a chunk at a time.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+
+#include <tms99XXpage.h>
+
+/*** setup page flipping ***/
+void initTMS99XXpageFlip(struct s_tms99XX_pageFlip * const p_pageFlip, struct s_tms99XX * const p_tms99XX, uint16_t nameAddr, uint16_t spriteAttributeAddr)
+{
+  /**** NULL Check ****/
+  if(!p_pageFlip) return;
+  
+  if(!p_tms99XX) return;
+  
+  p_pageFlip->nameAddr[0] = p_tms99XX->nameTableAddr;
+  
+  p_pageFlip->spriteAttributeAddr[0] = p_tms99XX->spriteAttributeAddr;
+  
+  p_pageFlip->nameAddr[1] = nameAddr;
+  
+  p_pageFlip->spriteAttributeAddr[1] = spriteAttributeAddr;
+  
+  p_pageFlip->front = 0;
+  
+  p_pageFlip->syncOffset = 0;
+  
+  p_pageFlip->syncSize = 0;
+}
+
+/*** back page name table ***/
+uint16_t getTMS99XXpageName(struct s_tms99XX_pageFlip * const p_pageFlip)
+{
+  /**** NULL Check ****/
+  if(!p_pageFlip) return 0;
+  
+  return p_pageFlip->nameAddr[p_pageFlip->front ^ 1];
+}
+
+/*** back page sprite attribute table ***/
+uint16_t getTMS99XXpageSpriteAttribute(struct s_tms99XX_pageFlip * const p_pageFlip)
+{
+  /**** NULL Check ****/
+  if(!p_pageFlip) return 0;
+  
+  return p_pageFlip->spriteAttributeAddr[p_pageFlip->front ^ 1];
+}
+
+/*** show the back page ***/
+uint8_t flipTMS99XXpage(struct s_tms99XX_pageFlip * const p_pageFlip, struct s_tms99XX * const p_tms99XX, uint8_t sync)
+{
+  /**** NULL Check ****/
+  if(!p_pageFlip) return 0;
+  
+  if(!p_tms99XX) return 0;
+  
+  /**** a flag or a low nINT left from mid frame would pass the wait at once, clear both so only a fresh blank counts ****/
+  p_tms99XX->vblankFlag = 0;
+  
+  getTMS99XXstatus(p_tms99XX);
+  
+  /**** both registers land in the same blank, no torn frame. no blank, no flip ****/
+  if(!waitTMS99XXvblank(p_tms99XX)) return 0;
+  
+  p_pageFlip->front ^= 1;
+  
+  p_tms99XX->nameTableAddr = p_pageFlip->nameAddr[p_pageFlip->front];
+  
+  p_tms99XX->spriteAttributeAddr = p_pageFlip->spriteAttributeAddr[p_pageFlip->front];
+  
+  setTMS99XXreg(p_tms99XX, REGISTER_2, (uint8_t)(p_tms99XX->nameTableAddr >> NAME_TABLE_ADDR_SCALE));
+  
+  if(p_tms99XX->vdpMode != TXT_MODE)
+  {
+    setTMS99XXreg(p_tms99XX, REGISTER_5, (uint8_t)(p_tms99XX->spriteAttributeAddr >> SPRITE_ATTRIBUTE_TABLE_ADDR_SCALE));
+  }
+  
+  p_pageFlip->syncOffset = 0;
+  
+  p_pageFlip->syncSize = 0;
+  
+  if(sync)
+  {
+    p_pageFlip->syncSize = (p_tms99XX->vdpMode == TXT_MODE ? TXT_NAME_TABLE_SIZE : NAME_TABLE_SIZE + SPRITE_ATTRIBUTE_TABLE_SIZE);
+  }
+  
+  return 1;
+}
+
+/*** copy a chunk of the front page to the back page ***/
+uint16_t syncTMS99XXpage(struct s_tms99XX_pageFlip * const p_pageFlip, struct s_tms99XX * const p_tms99XX)
+{
+  uint16_t offset = 0;
+  uint16_t size = PAGE_SYNC_CHUNK;
+  uint16_t frontAddr = 0;
+  uint16_t backAddr = 0;
+  uint16_t tableSize = 0;
+  uint8_t  buffer[PAGE_SYNC_CHUNK];
+  
+  /**** NULL Check ****/
+  if(!p_pageFlip) return 0;
+  
+  if(!p_tms99XX) return 0;
+  
+  if(!p_pageFlip->syncSize) return 0;
+  
+  offset = p_pageFlip->syncOffset;
+  
+  tableSize = (p_tms99XX->vdpMode == TXT_MODE ? TXT_NAME_TABLE_SIZE : NAME_TABLE_SIZE);
+  
+  /**** name table first, then the sprite attribute table ****/
+  if(offset < tableSize)
+  {
+    frontAddr = (uint16_t)(p_pageFlip->nameAddr[p_pageFlip->front] + offset);
+    
+    backAddr = (uint16_t)(p_pageFlip->nameAddr[p_pageFlip->front ^ 1] + offset);
+  }
+  else
+  {
+    tableSize = SPRITE_ATTRIBUTE_TABLE_SIZE;
+    
+    offset -= (p_tms99XX->vdpMode == TXT_MODE ? TXT_NAME_TABLE_SIZE : NAME_TABLE_SIZE);
+    
+    frontAddr = (uint16_t)(p_pageFlip->spriteAttributeAddr[p_pageFlip->front] + offset);
+    
+    backAddr = (uint16_t)(p_pageFlip->spriteAttributeAddr[p_pageFlip->front ^ 1] + offset);
+  }
+  
+  if(size > (tableSize - offset)) size = (uint16_t)(tableSize - offset);
+  
+  setTMS99XXvramReadAddr(p_tms99XX, frontAddr);
+  
+  size = (uint16_t)getTMS99XXvramData(p_tms99XX, buffer, (int)size);
+  
+  setTMS99XXvramWriteAddr(p_tms99XX, backAddr);
+  
+  size = (uint16_t)setTMS99XXvramData(p_tms99XX, buffer, (int)size);
+  
+  p_pageFlip->syncOffset += size;
+  
+  p_pageFlip->syncSize -= size;
+  
+  return p_pageFlip->syncSize;
+}
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * @file    tms99XXprofile.c
+ * @brief   Mode profiles for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Mode profiles, a saved mode with its register set, table layout
+ *          and the blocks it needs in vram (fonts, patterns, colors). Residency is
+ *          kept by the upload cache, so any write over a block is seen. Switching
+ *          to a profile with every block resident is only the register writes,
+ *          else the missing blocks are uploaded with the screen blanked first.
+ *          Give each profile its own tables (see tms99XXlayout) and enough
+ *          UPLOAD_CACHE_ENTRIES for all of their assets.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXprofile.h>
+
+/*** save current mode ***/
+void initTMS99XXprofile(struct s_tms99XX_profile * const p_profile, struct s_tms99XX const * const p_tms99XX)
+{
+  /**** NULL Check ****/
+  if(!p_profile) return;
+  
+  if(!p_tms99XX) return;
+  
+  /**** mode, tables and third sharing all come back out of the registers ****/
+  getTMS99XXshadowRegs(p_tms99XX, p_profile->registers);
+  
+  p_profile->numAssets = 0;
+  
+  p_profile->resident = 0;
+  
+  p_profile->reloads = 0;
+}
+
+/*** add a needed block ***/
+uint8_t addTMS99XXprofileAsset(struct s_tms99XX_profile * const p_profile, uint16_t vramAddr, void const * const p_data, uint16_t size)
+{
+  struct s_tms99XX_profileAsset *p_asset = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_profile) return 0;
+  
+  if(!p_data) return 0;
+  
+  if(!size) return 0;
+  
+  if(p_profile->numAssets >= PROFILE_MAX_ASSETS) return 0;
+  
+  p_asset = &p_profile->assets[p_profile->numAssets++];
+  
+  p_asset->p_data = (uint8_t const *)p_data;
+  
+  p_asset->vramAddr = vramAddr & VRAM_ADDR_MASK;
+  
+  p_asset->size = size;
+  
+  /**** hashed once, switches only compare ****/
+  p_asset->hash = hashTMS99XXdata(p_data, size);
+  
+  return 1;
+}
+
+/*** switch to profile ***/
+uint8_t setTMS99XXprofile(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_profile * const p_profile)
+{
+  uint8_t index = 0;
+  uint8_t regNum = 0;
+  uint8_t display = 0;
+  
+  struct s_tms99XX_profileAsset const *p_asset = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_profile) return 0;
+  
+  /**** screen on or off and irq stay as they are, the profile holds the rest ****/
+  display = (uint8_t)(p_tms99XX->register1 & ((1 << BLK_SCRN_BIT) | (1 << IRQ_BIT)));
+  
+  if(checkTMS99XXprofileResident(p_tms99XX, p_profile))
+  {
+    p_profile->resident++;
+  }
+  else
+  {
+    p_profile->reloads++;
+    
+    /**** blanked and no interrupt, uploads run at full speed and nothing half loaded is shown ****/
+    p_tms99XX->register1 = (uint8_t)(p_tms99XX->register1 & ~((1 << BLK_SCRN_BIT) | (1 << IRQ_BIT)));
+    
+    setTMS99XXreg(p_tms99XX, REGISTER_1, p_tms99XX->register1);
+    
+    /**** resident blocks are skipped by the upload cache ****/
+    for(index = 0; index < p_profile->numAssets; index++)
+    {
+      p_asset = &p_profile->assets[index];
+      
+      if(!uploadTMS99XXvramFlash(p_tms99XX, p_asset->vramAddr, p_asset->p_data, p_asset->size)) return 0;
+    }
+  }
+  
+  setTMS99XXshadowRegs(p_tms99XX, p_profile->registers);
+  
+  p_tms99XX->register1 = (uint8_t)((p_tms99XX->register1 & ~((1 << BLK_SCRN_BIT) | (1 << IRQ_BIT))) | display);
+  
+  for(regNum = REGISTER_0; regNum <= REGISTER_7; regNum++)
+  {
+    setTMS99XXreg(p_tms99XX, regNum, (regNum == REGISTER_1 ? p_tms99XX->register1 : p_profile->registers[regNum]));
+  }
+  
+  return 1;
+}
+
+/*** resident check ***/
+uint8_t checkTMS99XXprofileResident(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_profile const * const p_profile)
+{
+  uint8_t index = 0;
+  
+  struct s_tms99XX_profileAsset const *p_asset = NULL;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_profile) return 0;
+  
+  for(index = 0; index < p_profile->numAssets; index++)
+  {
+    p_asset = &p_profile->assets[index];
+    
+    if(!checkTMS99XXuploadResident(p_tms99XX, p_asset->vramAddr, p_asset->size, p_asset->hash)) return 0;
+  }
+  
+  return 1;
+}
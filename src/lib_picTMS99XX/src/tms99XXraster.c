@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * @file    tms99XXraster.c
+ * @brief   Raster effects for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Raster effects, register changes at given scanlines, ex. a backdrop
+ *          color per band or a name table switch for a split screen status bar.
+ *          The VDP has no line interrupt, so the nINT edge stamped by
+ *          isrTMS99XXvblank is the reference and a compare on the same timer
+ *          fires each change, with the frame length from calibrateTMS99XXvblank.
+ *          Changes are register writes only, no vram bandwidth is used.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+
+#include <tms99XXraster.h>
+
+/** SEE MY PRIVATES **/
+/*** read the vblank timer ***/
+inline uint16_t readRasterTimer(struct s_tms99XX_raster * const p_raster);
+/*** fire every due entry, arm the compare for the next ***/
+inline void runRasterEntries(struct s_tms99XX_raster * const p_raster);
+
+/*** setup raster scheduler ***/
+void initTMS99XXraster(struct s_tms99XX_raster * const p_raster, struct s_tms99XX * const p_tms99XX, volatile unsigned char *p_compareL, volatile unsigned char *p_compareH)
+{
+  /**** NULL Check ****/
+  if(!p_raster) return;
+  
+  if(!p_tms99XX) return;
+  
+  if(!p_compareL) return;
+  
+  if(!p_compareH) return;
+  
+  p_raster->p_tms99XX = p_tms99XX;
+  
+  p_raster->p_compareL = p_compareL;
+  
+  p_raster->p_compareH = p_compareH;
+  
+  p_raster->numEntries = 0;
+  
+  p_raster->next = 0;
+  
+  p_raster->stamp = 0;
+  
+  p_raster->late = 0;
+}
+
+/*** set the changes made each frame ***/
+uint8_t setTMS99XXrasterList(struct s_tms99XX_raster * const p_raster, struct s_tms99XX_rasterEntry const * const p_entries, uint8_t numEntries)
+{
+  uint8_t  index = 0;
+  uint16_t lines = 0;
+  uint32_t ticks = 0;
+  
+  /**** NULL Check ****/
+  if(!p_raster) return 0;
+  
+  if(!p_raster->p_tms99XX) return 0;
+  
+  if(numEntries && !p_entries) return 0;
+  
+  if(numEntries > RASTER_MAX_ENTRIES) return 0;
+  
+  /**** frame length in ticks comes from calibration ****/
+  switch(p_raster->p_tms99XX->videoStandard)
+  {
+    case VIDEO_NTSC:
+      lines = NTSC_LINES;
+      break;
+    case VIDEO_PAL:
+      lines = PAL_LINES;
+      break;
+    default:
+      return 0;
+  }
+  
+  for(index = 0; index < numEntries; index++)
+  {
+    if(p_entries[index].scanline >= SCREEN_LINES) return 0;
+    
+    if(index && (p_entries[index].scanline < p_entries[index - 1].scanline)) return 0;
+  }
+  
+  /**** stop the interrupts using the old list while it changes ****/
+  p_raster->numEntries = 0;
+  
+  for(index = 0; index < numEntries; index++)
+  {
+    p_raster->entries[index] = p_entries[index];
+    
+    /**** nINT is at the end of the last active line, active line 0 starts every blank line later ****/
+    ticks = ((uint32_t)p_raster->p_tms99XX->framePeriod * (uint32_t)(lines - SCREEN_LINES + p_entries[index].scanline)) / lines;
+    
+    p_raster->ticks[index] = (uint16_t)(ticks > RASTER_LEAD_TICKS ? ticks - RASTER_LEAD_TICKS : 0);
+  }
+  
+  /**** the next vblank starts from the first entry ****/
+  p_raster->next = numEntries;
+  
+  p_raster->numEntries = numEntries;
+  
+  return 1;
+}
+
+/*** start of the frame ***/
+void isrTMS99XXrasterVblank(struct s_tms99XX_raster * const p_raster)
+{
+  /**** NULL Check ****/
+  if(!p_raster) return;
+  
+  if(!p_raster->numEntries) return;
+  
+  /**** a new frame, entries the last one missed are dropped ****/
+  p_raster->stamp = p_raster->p_tms99XX->vblankStamp;
+  
+  p_raster->next = 0;
+  
+  runRasterEntries(p_raster);
+}
+
+/*** compare match ***/
+void isrTMS99XXrasterCompare(struct s_tms99XX_raster * const p_raster)
+{
+  /**** NULL Check ****/
+  if(!p_raster) return;
+  
+  runRasterEntries(p_raster);
+}
+
+/** SEE MY PRIVATES **/
+/*** read the vblank timer, low byte first latches the high byte ***/
+inline uint16_t readRasterTimer(struct s_tms99XX_raster * const p_raster)
+{
+  uint8_t low = *p_raster->p_tms99XX->p_timerL;
+  
+  return (uint16_t)(((uint16_t)*p_raster->p_tms99XX->p_timerH << 8) | low);
+}
+
+/*** fire every due entry, arm the compare for the next ***/
+inline void runRasterEntries(struct s_tms99XX_raster * const p_raster)
+{
+  uint16_t target = 0;
+  
+  for(; p_raster->next < p_raster->numEntries; p_raster->next++)
+  {
+    target = (uint16_t)(p_raster->stamp + p_raster->ticks[p_raster->next]);
+    
+    /**** not due yet, arm and leave. timer wraps, so compare the difference ****/
+    if((int16_t)(readRasterTimer(p_raster) - target) < 0)
+    {
+      *p_raster->p_compareH = (uint8_t)(target >> 8);
+      
+      *p_raster->p_compareL = (uint8_t)target;
+      
+      /**** timer could have passed it while arming, a compare that never matches would stall the frame ****/
+      if((int16_t)(readRasterTimer(p_raster) - target) < 0) return;
+      
+      p_raster->late++;
+    }
+    
+    isrTMS99XXreg(p_raster->p_tms99XX, p_raster->entries[p_raster->next].regNum, p_raster->entries[p_raster->next].value);
+  }
+}
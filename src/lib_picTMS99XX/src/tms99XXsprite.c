@@ -0,0 +1,374 @@
+/*******************************************************************************
+ * @file    tms99XXsprite.c
+ * @brief   Sprite manager for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Sprite manager for the 4 sprites per scanline limit. Each
+ *          frame the sprites per line are counted in software using the
+ *          size and magnify bits of register 1. When any line is over the
+ *          limit the attribute table order is rotated every frame, so the
+ *          dropped sprites change each frame and all of them flicker
+ *          evenly instead of some vanishing. Work per frame is bounded,
+ *          at most 32 sprites of 32 lines each are counted.
+ *          Collisions use the VDP coincidence flag as the trigger and only
+ *          then find the exact pairs.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXsprite.h>
+
+/** SEE MY PRIVATES **/
+/*** get one line of sprite pixels, left pixel in bit 31 ***/
+inline uint32_t getSpriteRow(struct s_tms99XX * const p_tms99XX, union u_tms99XX_spriteAttributeTable const * const p_sprite, uint8_t const * const p_patterns, uint8_t row);
+/*** get left edge of a sprite ***/
+inline int16_t getSpriteLeft(union u_tms99XX_spriteAttributeTable const * const p_sprite);
+/*** pixel compare two sprites ***/
+inline uint8_t checkSpritePixels(struct s_tms99XX_spriteMux * const p_spriteMux, uint8_t const * const p_patterns, uint8_t first, uint8_t second, uint8_t height);
+
+/*** setup sprite manager ***/
+void initTMS99XXspriteMux(struct s_tms99XX_spriteMux * const p_spriteMux, struct s_tms99XX * const p_tms99XX, union u_tms99XX_spriteAttributeTable * const p_sprites, uint8_t numSprites)
+{
+  /**** NULL Check ****/
+  if(!p_spriteMux) return;
+  
+  if(!p_tms99XX) return;
+  
+  if(!p_sprites) return;
+  
+  p_spriteMux->p_tms99XX = p_tms99XX;
+  
+  p_spriteMux->p_sprites = p_sprites;
+  
+  p_spriteMux->numSprites = (uint8_t)(numSprites > SPRITE_MAX ? SPRITE_MAX : numSprites);
+  
+  p_spriteMux->rotate = 0;
+  
+  p_spriteMux->maxPerLine = 0;
+}
+
+/*** count sprites per line and write attribute table ***/
+uint8_t updateTMS99XXspriteMux(struct s_tms99XX_spriteMux * const p_spriteMux)
+{
+  int16_t  top = 0;
+  int16_t  line = 0;
+  int16_t  end = 0;
+  uint8_t  index = 0;
+  uint8_t  slot = 0;
+  uint8_t  height = 0;
+  uint8_t  numActive = 0;
+  int      amtWrote = 0;
+  
+  /**** NULL Check ****/
+  if(!p_spriteMux) return SPRITE_MUX_FAIL;
+  
+  /**** per line counts and the table live in the struct, too big for the stack ****/
+  memset(p_spriteMux->lineCount, 0, sizeof(p_spriteMux->lineCount));
+  
+  p_spriteMux->maxPerLine = 0;
+  
+  /**** count, stops at the first terminator just like the VDP ****/
+  for(numActive = 0; numActive < p_spriteMux->numSprites; numActive++)
+  {
+    height = getTMS99XXspriteLines(p_spriteMux->p_tms99XX, &p_spriteMux->p_sprites[numActive], &top);
+    
+    if(!height) break;
+    
+    end = (int16_t)(top + height);
+    
+    if(end > SCREEN_LINES) end = SCREEN_LINES;
+    
+    for(line = (top < 0 ? 0 : top); line < end; line++)
+    {
+      if(++p_spriteMux->lineCount[line] > p_spriteMux->maxPerLine)
+      {
+        p_spriteMux->maxPerLine = p_spriteMux->lineCount[line];
+      }
+    }
+  }
+  
+  /**** no overloaded line, application order is kept ****/
+  if((p_spriteMux->maxPerLine <= SPRITE_LINE_LIMIT) || (p_spriteMux->rotate >= numActive))
+  {
+    p_spriteMux->rotate = 0;
+  }
+  
+  for(index = 0; index < numActive; index++)
+  {
+    slot = (uint8_t)(index + p_spriteMux->rotate);
+    
+    if(slot >= numActive) slot -= numActive;
+    
+    memcpy(&p_spriteMux->buffer[index * sizeof(union u_tms99XX_spriteAttributeTable)], p_spriteMux->p_sprites[slot].data, sizeof(union u_tms99XX_spriteAttributeTable));
+  }
+  
+  /**** terminate the table after the active sprites ****/
+  index = (uint8_t)(numActive * sizeof(union u_tms99XX_spriteAttributeTable));
+  
+  if(numActive < SPRITE_MAX)
+  {
+    p_spriteMux->buffer[index++] = SPRITE_TERM;
+  }
+  
+  setTMS99XXvramWriteAddr(p_spriteMux->p_tms99XX, p_spriteMux->p_tms99XX->spriteAttributeAddr);
+  
+  for(slot = 0; slot < index; slot += (uint8_t)amtWrote)
+  {
+    amtWrote = setTMS99XXvramData(p_spriteMux->p_tms99XX, &p_spriteMux->buffer[slot], index - slot);
+    
+    /**** timed out, the rotation stays so the next frame writes this one again ****/
+    if(!amtWrote) return SPRITE_MUX_FAIL;
+  }
+  
+  /**** overloaded, next frame starts one sprite later ****/
+  if(p_spriteMux->maxPerLine > SPRITE_LINE_LIMIT)
+  {
+    p_spriteMux->rotate = (uint8_t)(p_spriteMux->rotate + 1 >= numActive ? 0 : p_spriteMux->rotate + 1);
+  }
+  
+  return p_spriteMux->maxPerLine;
+}
+
+/*** get lines a sprite covers ***/
+uint8_t getTMS99XXspriteLines(struct s_tms99XX * const p_tms99XX, union u_tms99XX_spriteAttributeTable const * const p_sprite, int16_t *p_top)
+{
+  uint8_t height = 8;
+  
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+  
+  if(!p_sprite) return 0;
+  
+  if(!p_top) return 0;
+  
+  if(p_sprite->dataNibbles.verticalPos == SPRITE_TERM) return 0;
+  
+  if((p_tms99XX->register1 >> SPRITE_SIZE_BIT) & 0x01) height <<= 1;
+  
+  if((p_tms99XX->register1 >> SPRITE_MAG_BIT) & 0x01) height <<= 1;
+  
+  /**** vertical position is one line above the sprite, values past 0xE0 are above the screen ****/
+  *p_top = (int16_t)(p_sprite->dataNibbles.verticalPos + 1);
+  
+  if(p_sprite->dataNibbles.verticalPos > 0xE0)
+  {
+    *p_top -= 256;
+  }
+  
+  return height;
+}
+
+/*** find colliding sprite pairs ***/
+uint8_t checkTMS99XXspriteCollision(struct s_tms99XX_spriteMux * const p_spriteMux, uint8_t const * const p_patterns, struct s_tms99XX_spritePair * const p_pairs, uint8_t maxPairs)
+{
+  int16_t  top = 0;
+  int16_t  left = 0;
+  int16_t  otherTop = 0;
+  int16_t  otherLeft = 0;
+  uint8_t  cell = 0;
+  uint8_t  col = 0;
+  uint8_t  row = 0;
+  uint8_t  first = 0;
+  uint8_t  second = 0;
+  uint8_t  height = 0;
+  uint8_t  numActive = 0;
+  uint8_t  numPairs = 0;
+  uint32_t grid[SPRITE_GRID_COLS * SPRITE_GRID_ROWS];
+  
+  /**** NULL Check ****/
+  if(!p_spriteMux) return 0;
+  
+  if(!p_patterns) return 0;
+  
+  if(!p_pairs) return 0;
+  
+  /**** no coincidence reported by the VDP, nothing to pay for. the other latched bits belong to other readers ****/
+  if(!getTMS99XXstatusLatchMask(p_spriteMux->p_tms99XX, (uint8_t)(1 << STATUS_COL_BIT))) return 0;
+  
+  memset(grid, 0, sizeof(grid));
+  
+  /**** broad phase, mark every grid cell a sprite box touches ****/
+  for(numActive = 0; numActive < p_spriteMux->numSprites; numActive++)
+  {
+    height = getTMS99XXspriteLines(p_spriteMux->p_tms99XX, &p_spriteMux->p_sprites[numActive], &top);
+    
+    if(!height) break;
+    
+    left = getSpriteLeft(&p_spriteMux->p_sprites[numActive]);
+    
+    for(row = 0; row < SPRITE_GRID_ROWS; row++)
+    {
+      if((top >= ((row + 1) << SPRITE_GRID_SHIFT)) || ((top + height) <= (row << SPRITE_GRID_SHIFT))) continue;
+      
+      for(col = 0; col < SPRITE_GRID_COLS; col++)
+      {
+        if((left >= ((col + 1) << SPRITE_GRID_SHIFT)) || ((left + height) <= (col << SPRITE_GRID_SHIFT))) continue;
+        
+        grid[(row * SPRITE_GRID_COLS) + col] |= ((uint32_t)1 << numActive);
+      }
+    }
+  }
+  
+  /**** narrow phase on pairs sharing a cell ****/
+  for(cell = 0; cell < (SPRITE_GRID_COLS * SPRITE_GRID_ROWS); cell++)
+  {
+    if(!grid[cell]) continue;
+    
+    for(first = 0; first < numActive; first++)
+    {
+      if(!((grid[cell] >> first) & 0x01)) continue;
+      
+      for(second = (uint8_t)(first + 1); second < numActive; second++)
+      {
+        if(!((grid[cell] >> second) & 0x01)) continue;
+        
+        /**** pairs share up to 4 cells, only test in the cell holding the overlap corner ****/
+        height = getTMS99XXspriteLines(p_spriteMux->p_tms99XX, &p_spriteMux->p_sprites[first], &top);
+        
+        getTMS99XXspriteLines(p_spriteMux->p_tms99XX, &p_spriteMux->p_sprites[second], &otherTop);
+        
+        left = getSpriteLeft(&p_spriteMux->p_sprites[first]);
+        
+        otherLeft = getSpriteLeft(&p_spriteMux->p_sprites[second]);
+        
+        if(otherTop > top) top = otherTop;
+        
+        if(otherLeft > left) left = otherLeft;
+        
+        if(top < 0) top = 0;
+        
+        if(left < 0) left = 0;
+        
+        if(cell != (((top >> SPRITE_GRID_SHIFT) * SPRITE_GRID_COLS) + (left >> SPRITE_GRID_SHIFT))) continue;
+        
+        if(!checkSpritePixels(p_spriteMux, p_patterns, first, second, height)) continue;
+        
+        if(numPairs >= maxPairs) return numPairs;
+        
+        p_pairs[numPairs].first = first;
+        
+        p_pairs[numPairs].second = second;
+        
+        numPairs++;
+      }
+    }
+  }
+  
+  return numPairs;
+}
+
+/** SEE MY PRIVATES **/
+/*** get one line of sprite pixels ***/
+inline uint32_t getSpriteRow(struct s_tms99XX * const p_tms99XX, union u_tms99XX_spriteAttributeTable const * const p_sprite, uint8_t const * const p_patterns, uint8_t row)
+{
+  uint8_t  index = 0;
+  uint16_t bits = 0;
+  uint32_t magBits = 0;
+  uint16_t base = (uint16_t)p_sprite->dataNibbles.name << 3;
+  
+  if((p_tms99XX->register1 >> SPRITE_MAG_BIT) & 0x01) row >>= 1;
+  
+  /**** 16x16 uses 4 patterns, left column then right column ****/
+  if((p_tms99XX->register1 >> SPRITE_SIZE_BIT) & 0x01)
+  {
+    base &= (uint16_t)~0x1F;
+    
+    bits = (uint16_t)(((uint16_t)p_patterns[base + row] << 8) | p_patterns[base + 16 + row]);
+  }
+  else
+  {
+    bits = (uint16_t)((uint16_t)p_patterns[base + row] << 8);
+  }
+  
+  if(!((p_tms99XX->register1 >> SPRITE_MAG_BIT) & 0x01)) return (uint32_t)bits << 16;
+  
+  /**** magnify doubles every pixel ****/
+  for(index = 0; index < 16; index++)
+  {
+    if((bits >> (15 - index)) & 0x01)
+    {
+      magBits |= (uint32_t)3 << (30 - (index << 1));
+    }
+  }
+  
+  return magBits;
+}
+
+/*** get left edge of a sprite ***/
+inline int16_t getSpriteLeft(union u_tms99XX_spriteAttributeTable const * const p_sprite)
+{
+  /**** early clock moves the sprite 32 pixels left ****/
+  return (int16_t)(p_sprite->dataNibbles.horizontalPos - (p_sprite->dataNibbles.earlyClockBit ? 32 : 0));
+}
+
+/*** pixel compare two sprites ***/
+inline uint8_t checkSpritePixels(struct s_tms99XX_spriteMux * const p_spriteMux, uint8_t const * const p_patterns, uint8_t first, uint8_t second, uint8_t height)
+{
+  int16_t  top = 0;
+  int16_t  otherTop = 0;
+  int16_t  line = 0;
+  int16_t  end = 0;
+  int16_t  left = getSpriteLeft(&p_spriteMux->p_sprites[first]);
+  int16_t  otherLeft = getSpriteLeft(&p_spriteMux->p_sprites[second]);
+  int16_t  shift = (int16_t)(otherLeft - left);
+  uint32_t bits = 0;
+  uint32_t otherBits = 0;
+  uint32_t screenMask = 0xFFFFFFFF;
+  
+  if((shift >= height) || (shift <= -height)) return 0;
+  
+  getTMS99XXspriteLines(p_spriteMux->p_tms99XX, &p_spriteMux->p_sprites[first], &top);
+  
+  getTMS99XXspriteLines(p_spriteMux->p_tms99XX, &p_spriteMux->p_sprites[second], &otherTop);
+  
+  line = (int16_t)(top > otherTop ? top : otherTop);
+  
+  end = (int16_t)((top < otherTop ? top : otherTop) + height);
+  
+  if(line < 0) line = 0;
+  
+  if(end > SCREEN_LINES) end = SCREEN_LINES;
+  
+  /**** pixels left or right of the screen never collide ****/
+  if(left < 0) screenMask = (left > -32 ? screenMask >> -left : 0);
+  
+  if((left + 32) > 256) screenMask &= (uint32_t)0xFFFFFFFF << ((left + 32) - 256);
+  
+  for(; line < end; line++)
+  {
+    bits = getSpriteRow(p_spriteMux->p_tms99XX, &p_spriteMux->p_sprites[first], p_patterns, (uint8_t)(line - top)) & screenMask;
+    
+    otherBits = getSpriteRow(p_spriteMux->p_tms99XX, &p_spriteMux->p_sprites[second], p_patterns, (uint8_t)(line - otherTop));
+    
+    /**** line up the second sprite with the first ****/
+    otherBits = (shift >= 0 ? (otherBits >> shift) : (otherBits << -shift));
+    
+    if(bits & otherBits) return 1;
+  }
+  
+  return 0;
+}
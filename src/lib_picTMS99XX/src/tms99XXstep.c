@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * @file    tms99XXstep.c
+ * @brief   Non-blocking VRAM operations for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Step-wise versions of VRAM clear, check, init and large writes.
+ *          Each call to stepTMS99XX moves at most STEP_CHUNK bytes and returns
+ *          the state, all progress is kept in a caller owned context so the main
+ *          loop keeps servicing I/O between slices. Every slice sets its own VRAM
+ *          address, other VDP access between slices is fine. With a vblank
+ *          timeout set by setTMS99XXvblankWait a paced slice never blocks longer
+ *          than the timeout, a timed out slice is simply retried by the next call.
+ *          The default timeout of 0 waits forever, a dead nINT then blocks the
+ *          first paced slice for good. Set one before stepping, VBLANK_IDLE
+ *          timeouts also need initTMS99XXvblankTimer. Checks read over the
+ *          bus, mirrored ranges are not served from RAM.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXstep.h>
+
+/** SEE MY PRIVATES **/
+/*** set up the context for a new operation ***/
+inline void startStep(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint8_t const *p_data, uint16_t size, uint8_t fillData, uint8_t verify);
+/*** write one slice ***/
+inline void writeStep(struct s_tms99XX_step * const p_step, uint16_t chunk);
+/*** read back and check one slice ***/
+inline void verifyStep(struct s_tms99XX_step * const p_step, uint16_t chunk);
+
+/*** start step-wise clear ***/
+void startTMS99XXstepClear(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX)
+{
+  startStep(p_step, p_tms99XX, 0x0000, NULL, MEM_SIZE, 0x00, 0);
+}
+
+/*** start step-wise check ***/
+void startTMS99XXstepCheck(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX)
+{
+  startStep(p_step, p_tms99XX, 0x0000, NULL, MEM_SIZE, STEP_CHECK_DATA, 1);
+}
+
+/*** init registers now, clear vram step-wise ***/
+void startTMS99XXstepInit(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX, uint8_t vdpMode, uint8_t backColor, volatile unsigned char *p_dataPortW, volatile unsigned char *p_dataPortR, volatile unsigned char *p_ctrlPortW, volatile unsigned char *p_intPortR)
+{
+  /**** NULL Check ****/
+  if(!p_step) return;
+  
+  if(!p_tms99XX) return;
+  
+  /**** reset and registers are a handful of bus cycles, the clear is what takes time ****/
+  initTMS99XX(p_tms99XX, vdpMode, backColor, p_dataPortW, p_dataPortR, p_ctrlPortW, p_intPortR);
+  
+  startTMS99XXstepClear(p_step, p_tms99XX);
+}
+
+/*** start step-wise write ***/
+void startTMS99XXstepWrite(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, void const * const p_data, uint16_t size)
+{
+  /**** NULL Check ****/
+  if(!p_data) return;
+  
+  startStep(p_step, p_tms99XX, vramAddr, (uint8_t const *)p_data, size, 0x00, 0);
+}
+
+/*** do one slice ***/
+uint8_t stepTMS99XX(struct s_tms99XX_step * const p_step)
+{
+  uint16_t chunk = 0;
+  
+  /**** NULL Check ****/
+  if(!p_step) return STEP_IDLE;
+  
+  if(p_step->state != STEP_BUSY) return p_step->state;
+  
+  chunk = p_step->size - p_step->index;
+  
+  if(chunk > STEP_CHUNK) chunk = STEP_CHUNK;
+  
+  if(p_step->phase == STEP_PHASE_WRITE)
+  {
+    writeStep(p_step, chunk);
+  }
+  else
+  {
+    verifyStep(p_step, chunk);
+  }
+  
+  /**** verify may have failed ****/
+  if(p_step->state != STEP_BUSY) return p_step->state;
+  
+  if(p_step->index < p_step->size) return STEP_BUSY;
+  
+  /**** phase done, start verify or finish ****/
+  if((p_step->phase == STEP_PHASE_WRITE) && p_step->verify)
+  {
+    p_step->phase = STEP_PHASE_VERIFY;
+    
+    p_step->index = 0;
+    
+    return STEP_BUSY;
+  }
+  
+  p_step->state = STEP_DONE;
+  
+  return STEP_DONE;
+}
+
+/*** percent done ***/
+uint8_t getTMS99XXstepProgress(struct s_tms99XX_step * const p_step)
+{
+  uint32_t done = 0;
+  uint32_t total = 0;
+  
+  /**** NULL Check ****/
+  if(!p_step) return 0;
+  
+  if(p_step->state == STEP_IDLE) return 0;
+  
+  if(p_step->state != STEP_BUSY) return 100;
+  
+  total = p_step->size;
+  
+  done = p_step->index;
+  
+  /**** check is two passes over the same size ****/
+  if(p_step->verify)
+  {
+    if(p_step->phase == STEP_PHASE_VERIFY) done += total;
+    
+    total <<= 1;
+  }
+  
+  if(!total) return 100;
+  
+  return (uint8_t)((done * 100) / total);
+}
+
+/*** stop operation ***/
+void abortTMS99XXstep(struct s_tms99XX_step * const p_step)
+{
+  /**** NULL Check ****/
+  if(!p_step) return;
+  
+  p_step->state = STEP_IDLE;
+}
+
+/** SEE MY PRIVATES **/
+/*** set up context ***/
+inline void startStep(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint8_t const *p_data, uint16_t size, uint8_t fillData, uint8_t verify)
+{
+  /**** NULL Check ****/
+  if(!p_step) return;
+  
+  if(!p_tms99XX) return;
+  
+  p_step->p_tms99XX = p_tms99XX;
+  
+  p_step->p_data = p_data;
+  
+  p_step->vramAddr = vramAddr;
+  
+  p_step->size = size;
+  
+  p_step->index = 0;
+  
+  p_step->fillData = fillData;
+  
+  p_step->verify = verify;
+  
+  p_step->phase = STEP_PHASE_WRITE;
+  
+  p_step->state = STEP_BUSY;
+}
+
+/*** write one slice, a timed out vblank wait writes 0 and the slice is retried ***/
+inline void writeStep(struct s_tms99XX_step * const p_step, uint16_t chunk)
+{
+  int amtWrote = 0;
+  
+  /**** address every slice, the caller may have used the vdp in between ****/
+  setTMS99XXvramWriteAddr(p_step->p_tms99XX, p_step->vramAddr + p_step->index);
+  
+  if(p_step->p_data)
+  {
+    amtWrote = setTMS99XXvramData(p_step->p_tms99XX, p_step->p_data + p_step->index, (int)chunk);
+  }
+  else
+  {
+    amtWrote = setTMS99XXvramConstData(p_step->p_tms99XX, p_step->fillData, (int)chunk);
+  }
+  
+  p_step->index += (uint16_t)amtWrote;
+}
+
+/*** read back one slice and check it against the fill data ***/
+inline void verifyStep(struct s_tms99XX_step * const p_step, uint16_t chunk)
+{
+  int     index = 0;
+  int     amtRead = 0;
+  uint8_t buffer[STEP_CHUNK];
+  
+  setTMS99XXvramReadAddr(p_step->p_tms99XX, p_step->vramAddr + p_step->index);
+  
+  /**** a mirror would hand back what was written, not what vram holds ****/
+  amtRead = getTMS99XXvramBusData(p_step->p_tms99XX, buffer, (int)chunk);
+  
+  for(index = 0; index < amtRead; index++)
+  {
+    if(buffer[index] != p_step->fillData)
+    {
+      p_step->state = STEP_FAIL;
+      
+      return;
+    }
+  }
+  
+  p_step->index += (uint16_t)amtRead;
+}
@@ -0,0 +1,420 @@
+/*******************************************************************************
+ * @file    tms99XXstore.c
+ * @brief   VRAM paged storage for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Paged storage in VRAM the tables do not use. Free regions, ex. the
+ *          free list of a planned layout, are handed to the store and split in
+ *          64 byte pages. Application buffers are allocated from those pages and
+ *          read or written by handle and offset. A few pages are cached in RAM
+ *          so repeated access to the same data does not touch the bus, dirty
+ *          pages go back to VRAM when evicted or flushed.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXstore.h>
+
+/** SEE MY PRIVATES **/
+/*** copy between a buffer and the page cache, p_read for a read, p_write for a write ***/
+inline uint16_t copyStore(struct s_tms99XX_store * const p_store, uint8_t handle, uint16_t offset, uint8_t *p_read, uint8_t const *p_write, uint16_t size);
+/*** find or load a page into the cache ***/
+inline struct s_tms99XX_storePage *getStorePage(struct s_tms99XX_store * const p_store, uint16_t vramAddr, uint8_t load);
+/*** write a dirty page back to vram ***/
+inline uint8_t writeStorePage(struct s_tms99XX_store * const p_store, struct s_tms99XX_storePage * const p_page);
+/*** check a page is free ***/
+inline uint8_t checkStoreFree(struct s_tms99XX_store const * const p_store, uint16_t page);
+/*** set or clear the free bit of a page ***/
+inline void setStoreFree(struct s_tms99XX_store * const p_store, uint16_t page, uint8_t free);
+
+/*** setup empty store ***/
+void initTMS99XXstore(struct s_tms99XX_store * const p_store, struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t index = 0;
+  
+  /**** NULL Check ****/
+  if(!p_store) return;
+  
+  if(!p_tms99XX) return;
+  
+  p_store->p_tms99XX = p_tms99XX;
+  
+  memset(p_store->freeMap, 0, sizeof(p_store->freeMap));
+  
+  memset(p_store->buffers, 0, sizeof(p_store->buffers));
+  
+  for(index = 0; index < STORE_CACHE_PAGES; index++)
+  {
+    p_store->pages[index].vramAddr = STORE_NO_PAGE;
+    
+    p_store->pages[index].lastUse = 0;
+    
+    p_store->pages[index].dirty = 0;
+  }
+  
+  p_store->clock = 0;
+  
+  clearTMS99XXstoreStats(p_store);
+}
+
+/*** add free vram ***/
+uint16_t addTMS99XXstoreRegion(struct s_tms99XX_store * const p_store, uint16_t vramAddr, uint16_t size)
+{
+  uint16_t page = 0;
+  uint16_t end = 0;
+  uint16_t added = 0;
+  
+  /**** NULL Check ****/
+  if(!p_store) return 0;
+  
+  if(vramAddr >= MEM_SIZE) return 0;
+  
+  if(size > (MEM_SIZE - vramAddr)) size = (uint16_t)(MEM_SIZE - vramAddr);
+  
+  /**** only whole pages, round the start up and the end down ****/
+  page = (uint16_t)((vramAddr + STORE_PAGE_SIZE - 1) >> STORE_PAGE_SHIFT);
+  
+  end = (uint16_t)((vramAddr + size) >> STORE_PAGE_SHIFT);
+  
+  for(; page < end; page++)
+  {
+    if(checkStoreFree(p_store, page)) continue;
+    
+    setStoreFree(p_store, page, 1);
+    
+    added += STORE_PAGE_SIZE;
+  }
+  
+  return added;
+}
+
+/*** allocate buffer ***/
+uint8_t allocTMS99XXstore(struct s_tms99XX_store * const p_store, uint16_t size)
+{
+  uint8_t  handle = 0;
+  uint16_t page = 0;
+  uint16_t run = 0;
+  uint16_t numPages = 0;
+  
+  /**** NULL Check ****/
+  if(!p_store) return STORE_NO_HANDLE;
+  
+  if(!size || (size > MEM_SIZE)) return STORE_NO_HANDLE;
+  
+  for(handle = 0; handle < STORE_MAX_HANDLES; handle++)
+  {
+    if(!p_store->buffers[handle].size) break;
+  }
+  
+  if(handle >= STORE_MAX_HANDLES) return STORE_NO_HANDLE;
+  
+  numPages = (uint16_t)((size + STORE_PAGE_SIZE - 1) >> STORE_PAGE_SHIFT);
+  
+  /**** first fit, count a run of free pages ****/
+  for(page = 0; page < STORE_PAGES; page++)
+  {
+    run = (uint16_t)(checkStoreFree(p_store, page) ? run + 1 : 0);
+    
+    if(run == numPages) break;
+  }
+  
+  if(run != numPages) return STORE_NO_HANDLE;
+  
+  page = (uint16_t)(page + 1 - numPages);
+  
+  p_store->buffers[handle].addr = (uint16_t)(page << STORE_PAGE_SHIFT);
+  
+  p_store->buffers[handle].size = size;
+  
+  for(run = 0; run < numPages; run++)
+  {
+    setStoreFree(p_store, (uint16_t)(page + run), 0);
+  }
+  
+  return handle;
+}
+
+/*** free buffer ***/
+void freeTMS99XXstore(struct s_tms99XX_store * const p_store, uint8_t handle)
+{
+  uint8_t  index = 0;
+  uint16_t page = 0;
+  uint16_t end = 0;
+  
+  /**** NULL Check ****/
+  if(!p_store) return;
+  
+  if(handle >= STORE_MAX_HANDLES) return;
+  
+  if(!p_store->buffers[handle].size) return;
+  
+  page = (uint16_t)(p_store->buffers[handle].addr >> STORE_PAGE_SHIFT);
+  
+  end = (uint16_t)(page + ((p_store->buffers[handle].size + STORE_PAGE_SIZE - 1) >> STORE_PAGE_SHIFT));
+  
+  /**** data is gone, no reason to write it back ****/
+  for(index = 0; index < STORE_CACHE_PAGES; index++)
+  {
+    if(p_store->pages[index].vramAddr == STORE_NO_PAGE) continue;
+    
+    if(((p_store->pages[index].vramAddr >> STORE_PAGE_SHIFT) < page) || ((p_store->pages[index].vramAddr >> STORE_PAGE_SHIFT) >= end)) continue;
+    
+    p_store->pages[index].vramAddr = STORE_NO_PAGE;
+    
+    p_store->pages[index].dirty = 0;
+  }
+  
+  for(; page < end; page++)
+  {
+    setStoreFree(p_store, page, 1);
+  }
+  
+  p_store->buffers[handle].size = 0;
+}
+
+/*** write buffer ***/
+uint16_t writeTMS99XXstore(struct s_tms99XX_store * const p_store, uint8_t handle, uint16_t offset, void const * const p_data, uint16_t size)
+{
+  /**** NULL Check ****/
+  if(!p_store) return 0;
+  
+  if(!p_data) return 0;
+  
+  return copyStore(p_store, handle, offset, NULL, (uint8_t const *)p_data, size);
+}
+
+/*** read buffer ***/
+uint16_t readTMS99XXstore(struct s_tms99XX_store * const p_store, uint8_t handle, uint16_t offset, void * const p_data, uint16_t size)
+{
+  /**** NULL Check ****/
+  if(!p_store) return 0;
+  
+  if(!p_data) return 0;
+  
+  return copyStore(p_store, handle, offset, (uint8_t *)p_data, NULL, size);
+}
+
+/*** write back dirty pages ***/
+uint8_t flushTMS99XXstore(struct s_tms99XX_store * const p_store)
+{
+  uint8_t index = 0;
+  uint8_t flushed = 1;
+  
+  /**** NULL Check ****/
+  if(!p_store) return 0;
+  
+  for(index = 0; index < STORE_CACHE_PAGES; index++)
+  {
+    if(!p_store->pages[index].dirty) continue;
+    
+    if(!writeStorePage(p_store, &p_store->pages[index])) flushed = 0;
+  }
+  
+  return flushed;
+}
+
+/*** free bytes ***/
+uint16_t getTMS99XXstoreFree(struct s_tms99XX_store const * const p_store)
+{
+  uint16_t page = 0;
+  uint16_t numFree = 0;
+  
+  /**** NULL Check ****/
+  if(!p_store) return 0;
+  
+  for(page = 0; page < STORE_PAGES; page++)
+  {
+    if(checkStoreFree(p_store, page)) numFree += STORE_PAGE_SIZE;
+  }
+  
+  return numFree;
+}
+
+/*** clear counters ***/
+void clearTMS99XXstoreStats(struct s_tms99XX_store * const p_store)
+{
+  /**** NULL Check ****/
+  if(!p_store) return;
+  
+  p_store->hits = 0;
+  
+  p_store->misses = 0;
+  
+  p_store->writeBacks = 0;
+}
+
+/** SEE MY PRIVATES **/
+/*** copy page by page, clipped to the buffer, only one of p_read or p_write is set ***/
+inline uint16_t copyStore(struct s_tms99XX_store * const p_store, uint8_t handle, uint16_t offset, uint8_t *p_read, uint8_t const *p_write, uint16_t size)
+{
+  uint16_t vramAddr = 0;
+  uint16_t pageOffset = 0;
+  uint16_t chunk = 0;
+  uint16_t done = 0;
+  
+  struct s_tms99XX_storePage *p_page = NULL;
+  
+  if(handle >= STORE_MAX_HANDLES) return 0;
+  
+  if(offset >= p_store->buffers[handle].size) return 0;
+  
+  if(size > (p_store->buffers[handle].size - offset)) size = (uint16_t)(p_store->buffers[handle].size - offset);
+  
+  vramAddr = (uint16_t)(p_store->buffers[handle].addr + offset);
+  
+  while(done < size)
+  {
+    pageOffset = (uint16_t)(vramAddr & (STORE_PAGE_SIZE - 1));
+    
+    chunk = (uint16_t)(STORE_PAGE_SIZE - pageOffset);
+    
+    if(chunk > (size - done)) chunk = (uint16_t)(size - done);
+    
+    /**** a write over the whole page does not need the old contents ****/
+    p_page = getStorePage(p_store, (uint16_t)(vramAddr - pageOffset), (uint8_t)(p_read || (chunk != STORE_PAGE_SIZE)));
+    
+    if(!p_page) break;
+    
+    if(p_read)
+    {
+      memcpy(p_read, &p_page->data[pageOffset], chunk);
+      
+      p_read += chunk;
+    }
+    else
+    {
+      memcpy(&p_page->data[pageOffset], p_write, chunk);
+      
+      p_write += chunk;
+      
+      p_page->dirty = 1;
+    }
+    
+    vramAddr += chunk;
+    
+    done += chunk;
+  }
+  
+  return done;
+}
+
+/*** find or load a page ***/
+inline struct s_tms99XX_storePage *getStorePage(struct s_tms99XX_store * const p_store, uint16_t vramAddr, uint8_t load)
+{
+  uint8_t index = 0;
+  
+  struct s_tms99XX_storePage *p_page = NULL;
+  
+  /**** clock wrapped, restart every page at the same age ****/
+  if(++p_store->clock == 0)
+  {
+    for(index = 0; index < STORE_CACHE_PAGES; index++)
+    {
+      p_store->pages[index].lastUse = 0;
+    }
+    
+    p_store->clock = 1;
+  }
+  
+  for(index = 0; index < STORE_CACHE_PAGES; index++)
+  {
+    if(p_store->pages[index].vramAddr != vramAddr) continue;
+    
+    p_store->pages[index].lastUse = p_store->clock;
+    
+    p_store->hits++;
+    
+    return &p_store->pages[index];
+  }
+  
+  p_store->misses++;
+  
+  /**** empty page first, else least recently used ****/
+  p_page = &p_store->pages[0];
+  
+  for(index = 0; index < STORE_CACHE_PAGES; index++)
+  {
+    if(p_store->pages[index].vramAddr == STORE_NO_PAGE)
+    {
+      p_page = &p_store->pages[index];
+      
+      break;
+    }
+    
+    if(p_store->pages[index].lastUse < p_page->lastUse) p_page = &p_store->pages[index];
+  }
+  
+  if(p_page->dirty && !writeStorePage(p_store, p_page)) return NULL;
+  
+  p_page->vramAddr = STORE_NO_PAGE;
+  
+  if(load)
+  {
+    setTMS99XXvramReadAddr(p_store->p_tms99XX, vramAddr);
+    
+    if(!getTMS99XXvramBlock(p_store->p_tms99XX, p_page->data, STORE_PAGE_SIZE)) return NULL;
+  }
+  
+  p_page->vramAddr = vramAddr;
+  
+  p_page->lastUse = p_store->clock;
+  
+  return p_page;
+}
+
+/*** write back one page ***/
+inline uint8_t writeStorePage(struct s_tms99XX_store * const p_store, struct s_tms99XX_storePage * const p_page)
+{
+  setTMS99XXvramWriteAddr(p_store->p_tms99XX, p_page->vramAddr);
+  
+  if(!setTMS99XXvramBlock(p_store->p_tms99XX, p_page->data, STORE_PAGE_SIZE, VRAM_SRC_RAM)) return 0;
+  
+  p_page->dirty = 0;
+  
+  p_store->writeBacks++;
+  
+  return 1;
+}
+
+/*** check free bit ***/
+inline uint8_t checkStoreFree(struct s_tms99XX_store const * const p_store, uint16_t page)
+{
+  return (uint8_t)((p_store->freeMap[page >> 3] >> (page & 0x07)) & 0x01);
+}
+
+/*** set or clear free bit ***/
+inline void setStoreFree(struct s_tms99XX_store * const p_store, uint16_t page, uint8_t free)
+{
+  if(free)
+  {
+    p_store->freeMap[page >> 3] |= (uint8_t)(1 << (page & 0x07));
+  }
+  else
+  {
+    p_store->freeMap[page >> 3] &= (uint8_t)~(1 << (page & 0x07));
+  }
+}
@@ -0,0 +1,282 @@
+/*******************************************************************************
+ * @file    tms99XXtileCache.c
+ * @brief   Tile pattern cache for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Least recently used cache of tiles in the pattern table. Maps
+ *          of more than 256 distinct tiles keep all tiles in flash and only
+ *          the ones asked for are uploaded, evicting the tile asked for
+ *          least recently. In graphics I a color table byte is shared by 8
+ *          patterns, a tile can only go in a group of slots with the same
+ *          color. Size the cache above the distinct tiles on screen, the
+ *          hit, miss and eviction counters show how it is doing.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tms99XXtileCache.h>
+
+/** SEE MY PRIVATES **/
+/*** pick the slot to load a tile into ***/
+inline uint8_t getTileCacheVictim(struct s_tms99XX_tileCache * const p_tileCache, uint8_t color);
+/*** check if a slot may take a tile of a color ***/
+inline uint8_t checkTileCacheGroup(struct s_tms99XX_tileCache * const p_tileCache, uint8_t slot, uint8_t color);
+/*** write all of a block to vram ***/
+inline uint8_t writeTileCacheVram(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint8_t const *p_data, uint8_t size);
+
+/*** setup tile cache ***/
+void initTMS99XXtileCache(struct s_tms99XX_tileCache * const p_tileCache, struct s_tms99XX * const p_tms99XX, struct s_tms99XX_tile const * const p_tiles, uint16_t numTiles, uint8_t firstSlot, uint8_t numSlots)
+{
+  uint16_t first = 0;
+  uint16_t last = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tileCache) return;
+  
+  if(!p_tms99XX) return;
+  
+  if(!p_tiles) return;
+  
+  p_tileCache->p_tms99XX = p_tms99XX;
+  
+  p_tileCache->p_tiles = p_tiles;
+  
+  p_tileCache->numTiles = numTiles;
+  
+  /**** 16 bit so the range end can be 256 ****/
+  first = firstSlot;
+  
+  last = first + numSlots;
+  
+  if(last > 256) last = 256;
+  
+  /**** whole color groups only ****/
+  if(p_tms99XX->vdpMode == GFXI_MODE)
+  {
+    first = (first + 7) & 0x1F8;
+    
+    last &= 0x1F8;
+  }
+  
+  /**** rounding ate the range ****/
+  if(last <= first)
+  {
+    first = 0;
+    
+    last = 0;
+  }
+  
+  if((last - first) > TILE_CACHE_SLOTS) last = first + TILE_CACHE_SLOTS;
+  
+  if(p_tms99XX->vdpMode == GFXI_MODE) last = first + ((last - first) & 0x1F8);
+  
+  p_tileCache->firstSlot = (uint8_t)first;
+  
+  p_tileCache->numSlots = (uint8_t)(last - first);
+  
+  flushTMS99XXtileCache(p_tileCache);
+  
+  clearTMS99XXtileCacheStats(p_tileCache);
+}
+
+/*** get pattern number of a tile ***/
+uint16_t getTMS99XXtileCacheName(struct s_tms99XX_tileCache * const p_tileCache, uint16_t tileId)
+{
+  uint8_t slot = 0;
+  uint8_t name = 0;
+  uint8_t color = 0;
+  
+  /**** NULL Check ****/
+  if(!p_tileCache) return TILE_NONE;
+  
+  if(!p_tileCache->numSlots) return TILE_NONE;
+  
+  if(tileId >= p_tileCache->numTiles) return TILE_NONE;
+  
+  /**** clock wrapped, restart every slot at the same age ****/
+  if(++p_tileCache->clock == 0)
+  {
+    memset(p_tileCache->lastUse, 0, sizeof(p_tileCache->lastUse));
+    
+    p_tileCache->clock = 1;
+  }
+  
+  for(slot = 0; slot < p_tileCache->numSlots; slot++)
+  {
+    if(p_tileCache->tileId[slot] != tileId) continue;
+    
+    p_tileCache->lastUse[slot] = p_tileCache->clock;
+    
+    p_tileCache->hits++;
+    
+    return (uint8_t)(p_tileCache->firstSlot + slot);
+  }
+  
+  p_tileCache->misses++;
+  
+  color = p_tileCache->p_tiles[tileId].color.data;
+  
+  slot = getTileCacheVictim(p_tileCache, color);
+  
+  name = (uint8_t)(p_tileCache->firstSlot + slot);
+  
+  p_tileCache->lastUse[slot] = p_tileCache->clock;
+  
+  /**** slot holds a partial pattern till the upload completes ****/
+  p_tileCache->tileId[slot] = TILE_NONE;
+  
+  if(!writeTileCacheVram(p_tileCache->p_tms99XX, (uint16_t)(p_tileCache->p_tms99XX->patternTableAddr + ((uint16_t)name << 3)), p_tileCache->p_tiles[tileId].pattern.data, sizeof(p_tileCache->p_tiles[tileId].pattern.data))) return TILE_NONE;
+  
+  p_tileCache->tileId[slot] = tileId;
+  
+  /**** graphics I, group color only written when it changes ****/
+  if((p_tileCache->p_tms99XX->vdpMode == GFXI_MODE) && ((p_tileCache->groupColor[slot >> 3] != color) || !((p_tileCache->groupValid >> (slot >> 3)) & 0x01)))
+  {
+    p_tileCache->groupValid &= ~((uint32_t)1 << (slot >> 3));
+    
+    if(!writeTileCacheVram(p_tileCache->p_tms99XX, (uint16_t)(p_tileCache->p_tms99XX->colorTableAddr + (name >> 3)), &color, sizeof(color)))
+    {
+      p_tileCache->tileId[slot] = TILE_NONE;
+      
+      return TILE_NONE;
+    }
+    
+    p_tileCache->groupColor[slot >> 3] = color;
+    
+    p_tileCache->groupValid |= ((uint32_t)1 << (slot >> 3));
+  }
+  
+  return name;
+}
+
+/*** clear counters ***/
+void clearTMS99XXtileCacheStats(struct s_tms99XX_tileCache * const p_tileCache)
+{
+  /**** NULL Check ****/
+  if(!p_tileCache) return;
+  
+  p_tileCache->hits = 0;
+  
+  p_tileCache->misses = 0;
+  
+  p_tileCache->evictions = 0;
+}
+
+/*** forget loaded tiles ***/
+void flushTMS99XXtileCache(struct s_tms99XX_tileCache * const p_tileCache)
+{
+  /**** NULL Check ****/
+  if(!p_tileCache) return;
+  
+  memset(p_tileCache->tileId, 0xFF, sizeof(p_tileCache->tileId));
+  
+  memset(p_tileCache->lastUse, 0, sizeof(p_tileCache->lastUse));
+  
+  memset(p_tileCache->groupColor, 0x00, sizeof(p_tileCache->groupColor));
+  
+  p_tileCache->groupValid = 0;
+  
+  p_tileCache->clock = 0;
+}
+
+/** SEE MY PRIVATES **/
+/*** pick a slot, empty first then least recently used ***/
+inline uint8_t getTileCacheVictim(struct s_tms99XX_tileCache * const p_tileCache, uint8_t color)
+{
+  uint8_t  slot = 0;
+  uint8_t  victim = 0xFF;
+  uint16_t oldest = 0xFFFF;
+  
+  for(slot = 0; slot < p_tileCache->numSlots; slot++)
+  {
+    if(!checkTileCacheGroup(p_tileCache, slot, color)) continue;
+    
+    if(p_tileCache->tileId[slot] == TILE_NONE) return slot;
+    
+    if(p_tileCache->lastUse[slot] < oldest)
+    {
+      oldest = p_tileCache->lastUse[slot];
+      
+      victim = slot;
+    }
+  }
+  
+  /**** no group can take the color, throw out the least recently used group ****/
+  if(victim == 0xFF)
+  {
+    for(slot = 0; slot < p_tileCache->numSlots; slot++)
+    {
+      if(p_tileCache->lastUse[slot] < oldest)
+      {
+        oldest = p_tileCache->lastUse[slot];
+        
+        victim = slot;
+      }
+    }
+    
+    victim &= 0xF8;
+    
+    for(slot = victim; slot < (victim + 8); slot++)
+    {
+      if(p_tileCache->tileId[slot] != TILE_NONE) p_tileCache->evictions++;
+      
+      p_tileCache->tileId[slot] = TILE_NONE;
+    }
+    
+    return victim;
+  }
+  
+  p_tileCache->evictions++;
+  
+  return victim;
+}
+
+/*** can a slot take a tile of this color ***/
+inline uint8_t checkTileCacheGroup(struct s_tms99XX_tileCache * const p_tileCache, uint8_t slot, uint8_t color)
+{
+  uint8_t index = 0;
+  
+  if(p_tileCache->p_tms99XX->vdpMode != GFXI_MODE) return 1;
+  
+  if(p_tileCache->groupColor[slot >> 3] == color) return 1;
+  
+  /**** other color, only if this slot is the only one loaded in its group ****/
+  for(index = (slot & 0xF8); index < ((slot & 0xF8) + 8); index++)
+  {
+    if((index != slot) && (p_tileCache->tileId[index] != TILE_NONE)) return 0;
+  }
+  
+  return 1;
+}
+
+/*** write till the block is done or the write times out ***/
+inline uint8_t writeTileCacheVram(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint8_t const *p_data, uint8_t size)
+{
+  setTMS99XXvramWriteAddr(p_tms99XX, vramAddr);
+  
+  return setTMS99XXvramBlock(p_tms99XX, p_data, size, VRAM_SRC_RAM);
+}
@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * @file      combineBench.c
+ * @author    Jay Convertino
+ * @date      2026.10.19
+ * @brief     Time small VRAM writes with and without write combining.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <tms99XX.h>
+#include <tms99XXascii.h>
+
+/* number of small writes timed */
+#define BENCH_WRITES 256
+/* bytes in each small write */
+#define BENCH_SIZE   2
+
+/* configuration bits */
+#pragma config PLLSEL   = PLL3X
+#pragma config CFGPLLEN = ON
+#pragma config CPUDIV   = NOCLKDIV
+#pragma config LS48MHZ  = SYS48X8
+#pragma config FOSC     = INTOSCIO
+#pragma config PCLKEN   = OFF
+#pragma config FCMEN    = OFF
+#pragma config IESO     = OFF
+#pragma config nPWRTEN  = OFF
+#pragma config BOREN    = OFF
+#pragma config BORV     = 190
+#pragma config nLPBOR   = OFF
+#pragma config WDTEN    = OFF
+#pragma config WDTPS    = 32768
+#pragma config CCP2MX   = RC1
+#pragma config PBADEN   = OFF
+#pragma config MCLRE    = OFF
+
+const char c_plain[] = "PLAIN TICKS ";
+
+const char c_comb[] = "COMB  TICKS ";
+
+const char c_saved[] = "SAVED/CALL  ";
+
+const char c_tick[] = "1 TICK = 2/3 US, 256 WRITES OF 2 BYTES";
+
+/* timer 0 is 16 bit, fosc/4 with 1:8 prescale, 1.5 MHz */
+uint16_t readTimer(void)
+{
+  uint16_t ticks = TMR0L;
+
+  ticks |= (uint16_t)TMR0H << 8;
+
+  return ticks;
+}
+
+/* time BENCH_WRITES small writes to one contiguous block */
+uint16_t timeWrites(struct s_tms99XX *p_tms99XX)
+{
+  int      index = 0;
+  uint16_t start = 0;
+  uint8_t  block[BENCH_SIZE] = {0xF0, 0x0F};
+
+  setTMS99XXvramWriteAddr(p_tms99XX, PATTERN_TABLE_ADDR);
+
+  start = readTimer();
+
+  for(index = 0; index < BENCH_WRITES; index++)
+  {
+    setTMS99XXvramData(p_tms99XX, block, sizeof(block));
+  }
+
+  /* last bytes are part of the time */
+  flushTMS99XXcombine(p_tms99XX);
+
+  return readTimer() - start;
+}
+
+/* write a 16 bit value as 4 hex digits */
+void writeHex(struct s_tms99XX *p_tms99XX, uint16_t value)
+{
+  int     index = 0;
+  uint8_t digits[4];
+
+  for(index = 3; index >= 0; index--)
+  {
+    digits[index] = "0123456789ABCDEF"[value & 0x0F];
+
+    value >>= 4;
+  }
+
+  setTMS99XXvramData(p_tms99XX, digits, sizeof(digits));
+}
+
+void main(void)
+{
+  uint16_t plainTicks = 0;
+  uint16_t combTicks = 0;
+
+  /* contains ti chip object */
+  struct s_tms99XX tms99XX;
+  struct s_tms99XX_combine combine;
+
+  /* OSCCON SETUP */
+  OSCCONbits.IRCF = 0x7;
+  OSCCONbits.OSTS = 0;
+  OSCCONbits.SCS  = 0x3;
+
+  OSCCON2bits.PLLEN = 1;
+
+  /* disable analog inputs */
+  ANSELA = 0;
+  ANSELB = 0;
+  ANSELC = 0;
+  ANSELD = 0;
+  ANSELE = 0;
+
+  /* enable pull ups */
+  INTCON2bits.nRBPU = 0;
+  WPUB = 0xFF;
+  IOCB = 0;
+
+  /* timer 0 on, 16 bit, internal clock, 1:8 prescale */
+  T0CON = 0x82;
+
+  /* wait for chip to be ready */
+  __delay_ms(100);
+
+  /* setup ports in struct for proper i/o */
+  initTMS99XXport(&tms99XX, &TRISB, &TRISD, &TRISC, 3, 2, 0, 1, 6);
+
+  /* setup tms9928 chip and finish setting up struct, screen starts blank so writes run at bus speed */
+  initTMS99XX(&tms99XX, TXT_MODE, TMS_BLACK, &LATB, &PORTB, &LATD, &PORTC);
+
+  setTMS99XXtxtColor(&tms99XX, TMS_WHITE);
+
+  clearTMS99XXvramData(&tms99XX);
+
+  /* every call is its own transfer */
+  plainTicks = timeWrites(&tms99XX);
+
+  /* calls fill the buffer, one transfer per COMBINE_BUFFER_SIZE bytes */
+  setTMS99XXcombine(&tms99XX, &combine);
+
+  combTicks = timeWrites(&tms99XX);
+
+  setTMS99XXcombine(&tms99XX, NULL);
+
+  /* font over the bench pattern, then the results */
+  setTMS99XXvramWriteAddr(&tms99XX, PATTERN_TABLE_ADDR);
+
+  setTMS99XXvramFlashData(&tms99XX, c_tms99XX_ascii, sizeof(c_tms99XX_ascii));
+
+  setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (40 * 10));
+
+  setTMS99XXvramFlashData(&tms99XX, c_plain, sizeof(c_plain) - 1);
+
+  writeHex(&tms99XX, plainTicks);
+
+  setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (40 * 11));
+
+  setTMS99XXvramFlashData(&tms99XX, c_comb, sizeof(c_comb) - 1);
+
+  writeHex(&tms99XX, combTicks);
+
+  setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (40 * 12));
+
+  setTMS99XXvramFlashData(&tms99XX, c_saved, sizeof(c_saved) - 1);
+
+  writeHex(&tms99XX, (uint16_t)((plainTicks - combTicks) / BENCH_WRITES));
+
+  setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (40 * 23));
+
+  setTMS99XXvramFlashData(&tms99XX, c_tick, sizeof(c_tick) - 1);
+
+  /* enable screen */
+  setTMS99XXblank(&tms99XX, 0);
+
+  for(;;)
+  {
+    __delay_ms(1000);
+  }
+}
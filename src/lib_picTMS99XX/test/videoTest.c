@@ -7,8 +7,10 @@
 
 #include <xc.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <tms99XX.h>
 #include <tms99XXascii.h>
+#include <tms99XXlist.h>
 
 #define SPRITES_8X8_NUM   5
 #define SPRITES_16X16_NUM 4
@@ -32,6 +34,78 @@
 #pragma config PBADEN   = OFF
 #pragma config MCLRE    = OFF
 
+/* const at file scope lives in program memory, uploaded with table reads */
+const char c_helloWorld[] = "Hello World!!!";
+
+const char c_tag[] = "2022 Jay Convertino";
+
+const char c_gfxi[] = "GFX I";
+
+const char c_gfximag[] = "GFX I MAG";
+
+const char c_gfxlarge[] = "GFX I LARGE";
+
+const char c_gfxlargeMag[] = "GFX I L MAG";
+
+const char c_txtmode[] = "TXT";
+
+/* text mode strings, copied by the display list */
+const struct s_tms99XX_asset c_txtAssets[] = {
+  {(uint8_t const *)c_helloWorld, sizeof(c_helloWorld)},
+  {(uint8_t const *)c_tag, sizeof(c_tag)},
+  {(uint8_t const *)c_txtmode, sizeof(c_txtmode)}
+};
+
+/* text mode lines, hello world on line 12, tag and mode on the last line */
+const uint8_t c_txtList[] = {
+  LIST_ADDR(NAME_TABLE_ADDR + (40 * 11)),
+  LIST_ASSET(0),
+  LIST_ADDR(NAME_TABLE_ADDR + (40 * 23)),
+  LIST_ASSET(1),
+  LIST_ASSET(2),
+  LIST_END
+};
+
+/* 8x8 sprites */
+const struct s_tms99XX_spritePatternTable8x8 c_tms8x8sprites[] =
+{
+  {{0x99, 0x66, 0x66, 0x99, 0x99, 0x66, 0x66, 0x99}}, //ship 1
+  {{0x00, 0x18, 0x24, 0xFF, 0xFF, 0x24, 0x18, 0x00}}, //ship 2
+  {{0x24, 0x3C, 0x18, 0x3C, 0x66, 0x7E, 0xC3, 0xFF}}, //ship 3
+  {{0x24, 0x24, 0x24, 0x3C, 0x18, 0xFF, 0x66, 0xFF}}, //ship 4
+  {{0x81, 0x42, 0x3C, 0x18, 0x3C, 0x66, 0xFF, 0xFF}}  //ship 5
+};
+
+/* 16x16 sprites */
+const struct s_tms99XX_spritePatternTable16x16 c_tms16x16Sprites[] =
+{
+  {{0x01, 0x03, 0x23, 0x73, 0x3B, 0x19, 0x0C, 0x00, 0x3C, 0xF8, 0x63, 0x06, 0x0C, 0x0C, 0x18, 0x00,
+    0x00, 0x00, 0x0C, 0x38, 0x70, 0x40, 0x5F, 0x38, 0x20, 0x30, 0x9C, 0xCE, 0xC2, 0xE0, 0x60, 0x20}}, // dark pedals
+  {{0x00, 0x08, 0x0C, 0x0C, 0x04, 0x06, 0xF2, 0x3C, 0x00, 0x06, 0x1C, 0x19, 0x33, 0x23, 0x03, 0x01,
+    0x40, 0x60, 0x60, 0xC2, 0x8E, 0xBC, 0x20, 0x00, 0x1F, 0x4E, 0x60, 0x30, 0x18, 0x1C, 0x08, 0x00}}, // light pedals
+  {{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // center
+  {{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}  // center ring
+};
+
+/* colors for bitmap bars */
+const union u_tms99XX_BMPpixelBlock c_tmsWhitePixelBlock = {.dataNibbles = {TMS_WHITE, TMS_WHITE, TMS_WHITE, TMS_WHITE}};
+
+const union u_tms99XX_BMPpixelBlock c_tmsYellowPixelBlock = { .dataNibbles = {TMS_LIGHT_YELLOW, TMS_LIGHT_YELLOW, TMS_LIGHT_YELLOW, TMS_LIGHT_YELLOW}};
+
+const union u_tms99XX_BMPpixelBlock c_tmsCyanPixelBlock = { .dataNibbles = {TMS_CYAN, TMS_CYAN, TMS_CYAN, TMS_CYAN}};
+
+const union u_tms99XX_BMPpixelBlock c_tmsGreenPixelBlock = { .dataNibbles = {TMS_LIGHT_GREEN, TMS_LIGHT_GREEN, TMS_LIGHT_GREEN, TMS_LIGHT_GREEN}};
+
+const union u_tms99XX_BMPpixelBlock c_tmsMagentaPixelBlock = { .dataNibbles = {TMS_MAGENTA, TMS_MAGENTA, TMS_MAGENTA, TMS_MAGENTA}};
+
+const union u_tms99XX_BMPpixelBlock c_tmsRedPixelBlock = { .dataNibbles = {TMS_MEDIUM_RED, TMS_MEDIUM_RED, TMS_MEDIUM_RED, TMS_MEDIUM_RED}};
+
+const union u_tms99XX_BMPpixelBlock c_tmsBluePixelBlock = { .dataNibbles = {TMS_DARK_BLUE, TMS_DARK_BLUE, TMS_DARK_BLUE, TMS_DARK_BLUE}};
+
+const union u_tms99XX_BMPpixelBlock c_tmsBlackPixelBlock = { .dataNibbles = {TMS_BLACK, TMS_BLACK, TMS_BLACK, TMS_BLACK}};
+
 /* used since chip is read-modify write only */
 unsigned char g_porteBuffer = 0;
 
@@ -50,43 +124,8 @@ void main(void)
   
   /* contains ti chip object */
   struct s_tms99XX tms99XX;
-  
-  char helloWorld[] = "Hello World!!!";
-  
-  char tag[] = "2022 Jay Convertino";
-  
-  char gfxi[] = "GFX I";
-  
-  char gfximag[] = "GFX I MAG";
-
-  char gfxlarge[] = "GFX I LARGE";
-
-  char gfxlargeMag[] = "GFX I L MAG";
-  
-  char txtmode[] = "TXT";
-  
-  /* 8x8 sprites */
-  struct s_tms99XX_spritePatternTable8x8 tms8x8sprites[] =
-  {
-    {{0x99, 0x66, 0x66, 0x99, 0x99, 0x66, 0x66, 0x99}}, //ship 1
-    {{0x00, 0x18, 0x24, 0xFF, 0xFF, 0x24, 0x18, 0x00}}, //ship 2
-    {{0x24, 0x3C, 0x18, 0x3C, 0x66, 0x7E, 0xC3, 0xFF}}, //ship 3
-    {{0x24, 0x24, 0x24, 0x3C, 0x18, 0xFF, 0x66, 0xFF}}, //ship 4
-    {{0x81, 0x42, 0x3C, 0x18, 0x3C, 0x66, 0xFF, 0xFF}}  //ship 5
-  };
-
-  /* 16x16 sprites */
-  struct s_tms99XX_spritePatternTable16x16 tms16x16Sprites[] =
-  {
-    {{0x01, 0x03, 0x23, 0x73, 0x3B, 0x19, 0x0C, 0x00, 0x3C, 0xF8, 0x63, 0x06, 0x0C, 0x0C, 0x18, 0x00,
-      0x00, 0x00, 0x0C, 0x38, 0x70, 0x40, 0x5F, 0x38, 0x20, 0x30, 0x9C, 0xCE, 0xC2, 0xE0, 0x60, 0x20}}, // dark pedals
-    {{0x00, 0x08, 0x0C, 0x0C, 0x04, 0x06, 0xF2, 0x3C, 0x00, 0x06, 0x1C, 0x19, 0x33, 0x23, 0x03, 0x01,
-      0x40, 0x60, 0x60, 0xC2, 0x8E, 0xBC, 0x20, 0x00, 0x1F, 0x4E, 0x60, 0x30, 0x18, 0x1C, 0x08, 0x00}}, // light pedals
-    {{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // center
-    {{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}  // center ring
-  };
+  struct s_tms99XX_uploadCache uploadCache;
+  struct s_tms99XX_combine combine;
   
   /* sprites 16x16 */
   union u_tms99XX_spriteAttributeTable largeSprites[SPRITES_16X16_NUM] = {0};
@@ -94,23 +133,6 @@ void main(void)
   /* sprites 8x8 */
   union u_tms99XX_spriteAttributeTable sprites[SPRITES_8X8_NUM] = {0};
 
-  /* colors for bitmap bars */
-  union u_tms99XX_BMPpixelBlock tmsWhitePixelBlock = {.dataNibbles = {TMS_WHITE, TMS_WHITE, TMS_WHITE, TMS_WHITE}};
-
-  union u_tms99XX_BMPpixelBlock tmsYellowPixelBlock = { .dataNibbles = {TMS_LIGHT_YELLOW, TMS_LIGHT_YELLOW, TMS_LIGHT_YELLOW, TMS_LIGHT_YELLOW}};
-
-  union u_tms99XX_BMPpixelBlock tmsCyanPixelBlock = { .dataNibbles = {TMS_CYAN, TMS_CYAN, TMS_CYAN, TMS_CYAN}};
-
-  union u_tms99XX_BMPpixelBlock tmsGreenPixelBlock = { .dataNibbles = {TMS_LIGHT_GREEN, TMS_LIGHT_GREEN, TMS_LIGHT_GREEN, TMS_LIGHT_GREEN}};
-
-  union u_tms99XX_BMPpixelBlock tmsMagentaPixelBlock = { .dataNibbles = {TMS_MAGENTA, TMS_MAGENTA, TMS_MAGENTA, TMS_MAGENTA}};
-
-  union u_tms99XX_BMPpixelBlock tmsRedPixelBlock = { .dataNibbles = {TMS_MEDIUM_RED, TMS_MEDIUM_RED, TMS_MEDIUM_RED, TMS_MEDIUM_RED}};
-
-  union u_tms99XX_BMPpixelBlock tmsBluePixelBlock = { .dataNibbles = {TMS_DARK_BLUE, TMS_DARK_BLUE, TMS_DARK_BLUE, TMS_DARK_BLUE}};
-
-  union u_tms99XX_BMPpixelBlock tmsBlackPixelBlock = { .dataNibbles = {TMS_BLACK, TMS_BLACK, TMS_BLACK, TMS_BLACK}};
-  
   /* create struct to store ascii name table in order, removing first 32 null patterns */
   uint8_t nameTable[1 + (sizeof(c_tms99XX_ascii)/8) - 32] = {0};
 
@@ -159,6 +181,9 @@ void main(void)
   /* setup tms9928 chip and finish setting up struct */
   initTMS99XX(&tms99XX, GFXI_MODE, TMS_TRANSPARENT, &LATB, &PORTB, &LATD, &PORTC);
   
+  /* remember resident uploads, fonts are only sent again once overwritten */
+  setTMS99XXuploadCache(&tms99XX, &uploadCache);
+  
   setTMS99XXtxtColor(&tms99XX, TMS_WHITE);
   
   /* SYSTEM TESTS */
@@ -190,16 +215,14 @@ void main(void)
   setTMS99XXmode(&tms99XX, GFXI_MODE);
   
   /* ascii chars */
-  setTMS99XXvramWriteAddr(&tms99XX, PATTERN_TABLE_ADDR);
-  
-  setTMS99XXvramData(&tms99XX, c_tms99XX_ascii, sizeof(c_tms99XX_ascii));
+  uploadTMS99XXvramFlash(&tms99XX, PATTERN_TABLE_ADDR, c_tms99XX_ascii, sizeof(c_tms99XX_ascii));
   
   /* write 2022 Jay Convertino on top line */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
   
-  setTMS99XXvramData(&tms99XX, tag, sizeof(tag)); 
+  setTMS99XXvramFlashData(&tms99XX, c_tag, sizeof(c_tag)); 
   
-  setTMS99XXvramData(&tms99XX, gfxi, sizeof(gfxi));
+  setTMS99XXvramFlashData(&tms99XX, c_gfxi, sizeof(c_gfxi));
 
   /* set sprite size to 8x8 */
   setTMS99XXspriteSize(&tms99XX, 0);
@@ -209,9 +232,7 @@ void main(void)
   
   setTMS99XXvramConstData(&tms99XX, (TMS_DARK_BLUE << 4 | TMS_BLACK), 32);
   
-  setTMS99XXvramWriteAddr(&tms99XX, SPRITE_PATTERN_TABLE_ADDR);
-  
-  setTMS99XXvramData(&tms99XX, tms8x8sprites, sizeof(tms8x8sprites));
+  uploadTMS99XXvramFlash(&tms99XX, SPRITE_PATTERN_TABLE_ADDR, c_tms8x8sprites, sizeof(c_tms8x8sprites));
   
   /* setup sprites */
   for(spriteIndex = 0; spriteIndex < SPRITES_8X8_NUM; spriteIndex++)
@@ -273,9 +294,9 @@ void main(void)
   /* write 2022 Jay Convertino on top line */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
   
-  setTMS99XXvramData(&tms99XX, tag, sizeof(tag)); 
+  setTMS99XXvramFlashData(&tms99XX, c_tag, sizeof(c_tag)); 
   
-  setTMS99XXvramData(&tms99XX, gfximag, sizeof(gfximag));
+  setTMS99XXvramFlashData(&tms99XX, c_gfximag, sizeof(c_gfximag));
   
   for(index = 0; index < 1000; index++)
   {
@@ -311,9 +332,9 @@ void main(void)
   /* write 2022 Jay Convertino on top line */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
 
-  setTMS99XXvramData(&tms99XX, tag, sizeof(tag));
+  setTMS99XXvramFlashData(&tms99XX, c_tag, sizeof(c_tag));
 
-  setTMS99XXvramData(&tms99XX, gfxlarge, sizeof(gfxlarge));
+  setTMS99XXvramFlashData(&tms99XX, c_gfxlarge, sizeof(c_gfxlarge));
 
   /* set sprite size to 16x16 */
   setTMS99XXspriteSize(&tms99XX, 1);
@@ -326,9 +347,7 @@ void main(void)
   /* SET TO GREEN */
   setTMS99XXbackgroundColor(&tms99XX, TMS_MEDIUM_GREEN);
 
-  setTMS99XXvramWriteAddr(&tms99XX, SPRITE_PATTERN_TABLE_ADDR);
-
-  setTMS99XXvramData(&tms99XX, tms16x16Sprites, sizeof(tms16x16Sprites));
+  uploadTMS99XXvramFlash(&tms99XX, SPRITE_PATTERN_TABLE_ADDR, c_tms16x16Sprites, sizeof(c_tms16x16Sprites));
 
   /* setup largeSprites */
   for(spriteIndex = 0; spriteIndex < SPRITES_16X16_NUM; spriteIndex++)
@@ -398,9 +417,9 @@ void main(void)
   /* write 2022 Jay Convertino on top line */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
 
-  setTMS99XXvramData(&tms99XX, tag, sizeof(tag));
+  setTMS99XXvramFlashData(&tms99XX, c_tag, sizeof(c_tag));
 
-  setTMS99XXvramData(&tms99XX, gfxlargeMag, sizeof(gfxlargeMag));
+  setTMS99XXvramFlashData(&tms99XX, c_gfxlargeMag, sizeof(c_gfxlargeMag));
 
   /* test GFX sprite in mag mode */
   setTMS99XXspriteMagnify(&tms99XX, 1);
@@ -442,6 +461,9 @@ void main(void)
   /* test multicolor bitmap mode */
   setTMS99XXmode(&tms99XX, BMP_MODE);
 
+  /* 2 byte blocks are combined into 32 byte transfers */
+  setTMS99XXcombine(&tms99XX, &combine);
+  
   /* write to pattern table */
   setTMS99XXvramWriteAddr(&tms99XX, PATTERN_TABLE_ADDR);
 
@@ -454,37 +476,40 @@ void main(void)
   {
     if(index < 4)
     {
-      setTMS99XXvramData(&tms99XX, &tmsWhitePixelBlock, sizeof(tmsWhitePixelBlock));
+      setTMS99XXvramFlashData(&tms99XX, &c_tmsWhitePixelBlock, sizeof(c_tmsWhitePixelBlock));
     }
     else if(index < 8)
     {
-      setTMS99XXvramData(&tms99XX, &tmsYellowPixelBlock, sizeof(tmsYellowPixelBlock));
+      setTMS99XXvramFlashData(&tms99XX, &c_tmsYellowPixelBlock, sizeof(c_tmsYellowPixelBlock));
     }
     else if(index < 12)
     {
-      setTMS99XXvramData(&tms99XX, &tmsCyanPixelBlock, sizeof(tmsCyanPixelBlock));
+      setTMS99XXvramFlashData(&tms99XX, &c_tmsCyanPixelBlock, sizeof(c_tmsCyanPixelBlock));
     }
     else if(index < 16)
     {
-      setTMS99XXvramData(&tms99XX, &tmsGreenPixelBlock, sizeof(tmsGreenPixelBlock));
+      setTMS99XXvramFlashData(&tms99XX, &c_tmsGreenPixelBlock, sizeof(c_tmsGreenPixelBlock));
     }
     else if(index < 20)
     {
-      setTMS99XXvramData(&tms99XX, &tmsMagentaPixelBlock, sizeof(tmsMagentaPixelBlock));
+      setTMS99XXvramFlashData(&tms99XX, &c_tmsMagentaPixelBlock, sizeof(c_tmsMagentaPixelBlock));
     }
     else if(index < 24)
     {
-      setTMS99XXvramData(&tms99XX, &tmsRedPixelBlock, sizeof(tmsRedPixelBlock));
+      setTMS99XXvramFlashData(&tms99XX, &c_tmsRedPixelBlock, sizeof(c_tmsRedPixelBlock));
     }
     else if(index < 28)
     {
-      setTMS99XXvramData(&tms99XX, &tmsBluePixelBlock, sizeof(tmsBluePixelBlock));
+      setTMS99XXvramFlashData(&tms99XX, &c_tmsBluePixelBlock, sizeof(c_tmsBluePixelBlock));
     }
     else
     {
-      setTMS99XXvramData(&tms99XX, &tmsBlackPixelBlock, sizeof(tmsBlackPixelBlock));
+      setTMS99XXvramFlashData(&tms99XX, &c_tmsBlackPixelBlock, sizeof(c_tmsBlackPixelBlock));
     }
   }
+  
+  /* last bytes out, back to plain writes */
+  setTMS99XXcombine(&tms99XX, NULL);
 
   /* write to name table */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
@@ -524,10 +549,8 @@ void main(void)
   /* SET TO BLACK */
   setTMS99XXbackgroundColor(&tms99XX, TMS_BLACK);
   
-  /* write to pattern table */
-  setTMS99XXvramWriteAddr(&tms99XX, PATTERN_TABLE_ADDR);
-
-  setTMS99XXvramData(&tms99XX, c_tms99XX_ascii, sizeof(c_tms99XX_ascii));
+  /* write to pattern table, bitmap test overwrote the font so this one is sent */
+  uploadTMS99XXvramFlash(&tms99XX, PATTERN_TABLE_ADDR, c_tms99XX_ascii, sizeof(c_tms99XX_ascii));
   
   /* first ascii letter is space in this table, no image */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
@@ -539,17 +562,8 @@ void main(void)
   
   setTMS99XXvramData(&tms99XX, nameTable, sizeof(nameTable));
   
-  /* write hello world on line 12 */
-  setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (40 * 11));
-  
-  setTMS99XXvramData(&tms99XX, helloWorld, sizeof(helloWorld));
-  
-  /* write 2022 Jay Convertino on last line (24 (23, offset 0)) */
-  setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (40 * 23));
-  
-  setTMS99XXvramData(&tms99XX, tag, sizeof(tag));
-  
-  setTMS99XXvramData(&tms99XX, txtmode, sizeof(txtmode));
+  /* write hello world on line 12, 2022 Jay Convertino and TXT on last line (24 (23, offset 0)) */
+  runTMS99XXlist(&tms99XX, c_txtList, c_txtAssets, sizeof(c_txtAssets)/sizeof(c_txtAssets[0]));
   
   /* enable irq */
   /* when irq is enabled, polling will be used */
@@ -95,6 +95,71 @@ void initTMS99XX(struct s_tms99XX * const p_tms99XX, uint8_t vdpMode, uint8_t ba
  ******************************************************************************/
 void setTMS99XXmode(struct s_tms99XX * const p_tms99XX, uint8_t vdpMode);
 
+/***************************************************************************//**
+ * @brief   Set how the three screen thirds of graphics II use the pattern
+ *          and color tables. Shared thirds read the same 2K of table, so a
+ *          tile screen uploads and stores its patterns once instead of three
+ *          times. Registers 3 and 4 are written now if in graphics II mode,
+ *          else on the next setTMS99XXmode.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   gfx2Thirds GFX2_THIRDS_FULL, GFX2_THIRDS_SHARED, GFX2_THIRDS_MIXED
+ *          or GFX2_THIRDS_HYBRID.
+ ******************************************************************************/
+void setTMS99XXgfx2Thirds(struct s_tms99XX * const p_tms99XX, uint8_t gfx2Thirds);
+
+/***************************************************************************//**
+ * @brief   Get the graphics II register 3 or 4 value for the current table
+ *          address and third sharing.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   regNum REGISTER_3 (color) or REGISTER_4 (pattern).
+ * @return  register value, 0 for any other register.
+ ******************************************************************************/
+uint8_t getTMS99XXgfx2Reg(struct s_tms99XX const * const p_tms99XX, uint8_t regNum);
+
+/***************************************************************************//**
+ * @brief   Get which third of a graphics II table a screen third reads.
+ *          The table third starts at table address + (third * 0x800).
+ * 
+ * @param   gfx2Thirds third sharing, GFX2_THIRDS_FULL to GFX2_THIRDS_HYBRID.
+ * @param   table LAYOUT_COLOR or LAYOUT_PATTERN.
+ * @param   third screen third, 0 top to 2 bottom.
+ * @return  table third, 0 to 2.
+ ******************************************************************************/
+uint8_t getTMS99XXgfx2Third(uint8_t gfx2Thirds, uint8_t table, uint8_t third);
+
+/***************************************************************************//**
+ * @brief   Get the values of registers 0 to 7 the struct describes, the
+ *          same ones setTMS99XXmode writes.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_registers array of 8 to store the register values.
+ ******************************************************************************/
+void getTMS99XXshadowRegs(struct s_tms99XX const * const p_tms99XX, uint8_t * const p_registers);
+
+/***************************************************************************//**
+ * @brief   Set the struct from register values written to the VDP some
+ *          other way, ex. a boot image. The mode, table addresses and
+ *          graphics II third sharing are worked out from them. Nothing is
+ *          written to the VDP.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_registers array of the 8 register values.
+ ******************************************************************************/
+void setTMS99XXshadowRegs(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_registers);
+
+/***************************************************************************//**
+ * @brief   Set the struct for one register written with setTMS99XXreg, ex.
+ *          from a display list. A mode bit change works out the table
+ *          addresses and third sharing again. Nothing is written to the VDP.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   regNum register 0 to 7.
+ * @param   regData value written.
+ ******************************************************************************/
+void setTMS99XXshadowReg(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t regData);
+
 /***************************************************************************//**
  * @brief   Set the TMS99XX to blank the current sprite and pattern planes.
  * 
@@ -152,6 +217,18 @@ void setTMS99XXbackgroundColor(struct s_tms99XX * const p_tms99XX, uint8_t color
  ******************************************************************************/
 void setTMS99XXreg(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t regData);
 
+/***************************************************************************//**
+ * @brief   Set a register from an interrupt routine, ex. a raster effect.
+ *          No di/ei and no write combine flush. The vram address is set
+ *          again before the next transfer. Like setTMS99XXreg the struct
+ *          shadow registers are not changed.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   regNum register number to write to.
+ * @param   regData data to write to register.
+ ******************************************************************************/
+void isrTMS99XXreg(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t regData);
+
 /***************************************************************************//**
  * @brief   Write a pattern or patterns into vram pattern table. Alighned to 
  *          pattern data size.
@@ -190,20 +267,45 @@ void setTMS99XXvramReadAddr(struct s_tms99XX * const p_tms99XX, uint16_t vramAdd
  * @param   p_tms99XX pointer to struct to contain port data.
  * @param   p_data pointer to data to write to vdp.
  * @param   size number of bytes to write to VRAM.
- * @return  actual number of bytes wrote.
+ * @return  actual number of bytes wrote, 0 only if the vblank wait timed out.
  ******************************************************************************/
 int setTMS99XXvramData(struct s_tms99XX * const p_tms99XX, void const * const p_data, int size);
 
+/***************************************************************************//**
+ * @brief   Write array of byte data in program memory (const at file scope)
+ *          to VRAM. Bytes are streamed with table reads straight to the
+ *          bus, nothing is copied to RAM. p_data must point to program
+ *          memory, use setTMS99XXvramData for anything in RAM.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_data pointer to const data in program memory.
+ * @param   size number of bytes to write to VRAM.
+ * @return  actual number of bytes wrote, 0 only if the vblank wait timed out.
+ ******************************************************************************/
+int setTMS99XXvramFlashData(struct s_tms99XX * const p_tms99XX, void const * const p_data, int size);
+
 /***************************************************************************//**
  * @brief   Set all data in VRAM to a constant value of some size.
  * 
  * @param   p_tms99XX pointer to struct to contain port data.
  * @param   data the constant to write.
  * @param   size number of bytes to set.
- * @return  actual number of bytes wrote.
+ * @return  actual number of bytes wrote, 0 only if the vblank wait timed out.
  ******************************************************************************/
 int setTMS99XXvramConstData(struct s_tms99XX * const p_tms99XX, uint8_t const data, int size);
 
+/***************************************************************************//**
+ * @brief   Write all of a block to VRAM, taking as many vblanks as it needs.
+ *          For callers that want all or nothing instead of a byte count.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_data pointer to the block, or to the one byte for VRAM_SRC_CONST.
+ * @param   size number of bytes to write to VRAM.
+ * @param   source VRAM_SRC_RAM, VRAM_SRC_FLASH or VRAM_SRC_CONST.
+ * @return  1 when all of it was written, 0 if a vblank wait timed out.
+ ******************************************************************************/
+uint8_t setTMS99XXvramBlock(struct s_tms99XX * const p_tms99XX, void const * const p_data, uint16_t size, uint8_t source);
+
 /***************************************************************************//**
  * @brief   Set all vertical field of selected sprite number to the 0xD0. The 
  *          sprite terminator.
@@ -214,15 +316,200 @@ int setTMS99XXvramConstData(struct s_tms99XX * const p_tms99XX, uint8_t const da
 void setTMS99XXvramSpriteTerm(struct s_tms99XX * const p_tms99XX, uint8_t const num);
 
 /***************************************************************************//**
- * @brief   Read array of byte data to VRAM.
+ * @brief   Read array of byte data to VRAM. Reads that fit in a valid
+ *          mirror are copied from RAM, no bus access or vblank wait.
  * 
  * @param   p_tms99XX pointer to struct to contain port data.
  * @param   p_data pointer to data to store read data.
  * @param   size number of bytes to read from vram.
- * @return  actual number of bytes read.
+ * @return  actual number of bytes read, 0 only if the vblank wait timed out.
  ******************************************************************************/
 int getTMS99XXvramData(struct s_tms99XX * const p_tms99XX, void *p_data, int size);
 
+/***************************************************************************//**
+ * @brief   Read all of a block from VRAM, taking as many vblanks as it
+ *          needs. Mirrored ranges are read from RAM like getTMS99XXvramData.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_data pointer to data to store read data.
+ * @param   size number of bytes to read from vram.
+ * @return  1 when all of it was read, 0 if a vblank wait timed out.
+ ******************************************************************************/
+uint8_t getTMS99XXvramBlock(struct s_tms99XX * const p_tms99XX, void *p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Read array of byte data from VRAM over the bus, even in mirrored
+ *          ranges. For checks of what VRAM really holds.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_data pointer to data to store read data.
+ * @param   size number of bytes to read from vram.
+ * @return  actual number of bytes read, 0 only if the vblank wait timed out.
+ ******************************************************************************/
+int getTMS99XXvramBusData(struct s_tms99XX * const p_tms99XX, void *p_data, int size);
+
+/***************************************************************************//**
+ * @brief   Mirror a vram region in RAM. Library writes through this struct
+ *          are copied to the buffer, reads inside it are served from RAM.
+ *          The mirror starts invalid, fill it with loadTMS99XXvramMirror.
+ *          Writes through any other struct (group broadcast) are not seen,
+ *          reload the mirror after those.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_mirror pointer to struct to contain mirror data.
+ * @param   vramAddr 14 bit address of the start of the region.
+ * @param   p_buffer RAM buffer of size bytes.
+ * @param   size number of bytes to mirror.
+ ******************************************************************************/
+void addTMS99XXvramMirror(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_mirror * const p_mirror, uint16_t vramAddr, uint8_t *p_buffer, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Stop mirroring a region.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_mirror pointer to struct to contain mirror data.
+ ******************************************************************************/
+void removeTMS99XXvramMirror(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_mirror * const p_mirror);
+
+/***************************************************************************//**
+ * @brief   Read the region from vram into the buffer and mark it valid.
+ *          Leaves the read address at the end of the region.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_mirror pointer to struct to contain mirror data.
+ * @return  1 on success, 0 if a vblank wait timed out.
+ ******************************************************************************/
+uint8_t loadTMS99XXvramMirror(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_mirror * const p_mirror);
+
+/***************************************************************************//**
+ * @brief   Mark every mirror invalid, reads go to the bus till reloaded.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ ******************************************************************************/
+void invalidateTMS99XXvramMirrors(struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Forget what this struct caches over a range another struct on
+ *          the same VDP wrote, ex. a group broadcast. Overlapping mirrors
+ *          are marked invalid, overlapping uploads are forgotten and the
+ *          next transfer sets the address again.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   vramAddr 14 bit address of the start of the range.
+ * @param   size number of bytes written.
+ ******************************************************************************/
+void invalidateTMS99XXvramRange(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Bytes of reads served from RAM by all mirrors.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @return  total of bytesLocal over every mirror.
+ ******************************************************************************/
+uint32_t getTMS99XXmirrorBytesLocal(struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Clear the statistics of every mirror.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ ******************************************************************************/
+void clearTMS99XXmirrorStats(struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Attach a table of resident uploads. Uploads through
+ *          uploadTMS99XXvram are remembered by address, size and a hash of
+ *          the data, any write or clear over them forgets them. Writes
+ *          through another struct on the same VDP (group broadcast) are not
+ *          seen, call invalidateTMS99XXuploadCache after those.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_uploadCache pointer to struct to contain upload data, NULL to
+ *          detach.
+ ******************************************************************************/
+void setTMS99XXuploadCache(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_uploadCache * const p_uploadCache);
+
+/***************************************************************************//**
+ * @brief   Upload a block to VRAM unless the same data is already resident
+ *          at the same address. Blocks till the whole block is sent.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   vramAddr 14 bit address to upload to.
+ * @param   p_data pointer to data in RAM.
+ * @param   size number of bytes to upload.
+ * @return  1 if resident or sent, 0 if a transfer timed out.
+ ******************************************************************************/
+uint8_t uploadTMS99XXvram(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, void const * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Upload a block from program memory to VRAM unless the same data
+ *          is already resident at the same address.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   vramAddr 14 bit address to upload to.
+ * @param   p_data pointer to const data in program memory.
+ * @param   size number of bytes to upload.
+ * @return  1 if resident or sent, 0 if a transfer timed out.
+ ******************************************************************************/
+uint8_t uploadTMS99XXvramFlash(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, void const * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Forget every resident upload, ex. after VRAM was written some
+ *          other way.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ ******************************************************************************/
+void invalidateTMS99XXuploadCache(struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Check if a block is resident without touching the bus, ex. to
+ *          skip a whole set of uploads with the hashes kept from before.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   vramAddr 14 bit address the block was uploaded to.
+ * @param   size number of bytes in the block.
+ * @param   hash hash of the block from hashTMS99XXdata.
+ * @return  1 if resident, 0 if not or no upload cache is attached.
+ ******************************************************************************/
+uint8_t checkTMS99XXuploadResident(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size, uint16_t hash);
+
+/***************************************************************************//**
+ * @brief   Hash of a block, the same one the upload cache keeps, CRC-16-CCITT.
+ * 
+ * @param   p_data pointer to data in RAM or program memory.
+ * @param   size number of bytes to hash.
+ * @return  16 bit hash.
+ ******************************************************************************/
+uint16_t hashTMS99XXdata(void const * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Attach a write combine buffer. Writes through setTMS99XXvramData
+ *          and setTMS99XXvramFlashData of up to COMBINE_BUFFER_SIZE bytes
+ *          are copied to the buffer and report every byte as written.
+ *          Setting the write address to where the buffer ends continues it.
+ *          The buffer goes out as one transfer when it is full, at any
+ *          other address, read, register write or other write, and on
+ *          flushTMS99XXcombine. Flush before the end of a frame or anything
+ *          that expects the bytes in vram.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_combine pointer to struct to contain combine data, NULL to
+ *          detach. Bytes in an attached buffer are flushed first.
+ * @return  1 on success, 0 if the attached buffer could not be flushed, it
+ *          stays attached with its bytes.
+ ******************************************************************************/
+uint8_t setTMS99XXcombine(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_combine * const p_combine);
+
+/***************************************************************************//**
+ * @brief   Write the combined bytes to vram now.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @return  1 if the buffer is empty, 0 if a transfer timed out. Unsent bytes
+ *          are never dropped, they stay with their own address till a
+ *          flush sends them. Writes and reads that have to flush first
+ *          return 0 till then.
+ ******************************************************************************/
+uint8_t flushTMS99XXcombine(struct s_tms99XX * const p_tms99XX);
+
 /***************************************************************************//**
  * @brief   Read status register of VDP.
  * 
@@ -231,19 +518,112 @@ int getTMS99XXvramData(struct s_tms99XX * const p_tms99XX, void *p_data, int siz
  ******************************************************************************/
 uint8_t getTMS99XXstatus(struct s_tms99XX * const p_tms99XX);
 
+/***************************************************************************//**
+ * @brief   Get status bits latched since the last call and clear them. Every
+ *          transfer ends with a status read that clears the VDP flags, this
+ *          keeps the interrupt, fifth sprite and coincidence bits for later.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @return  Latched status bits, fifth sprite number is from the last read.
+ ******************************************************************************/
+uint8_t getTMS99XXstatusLatch(struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Get the latched status bits in a mask and clear only those, the
+ *          rest stay latched for other readers.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   mask status bits to get, ex. 1 << STATUS_COL_BIT.
+ * @return  Latched status bits in the mask.
+ ******************************************************************************/
+uint8_t getTMS99XXstatusLatchMask(struct s_tms99XX * const p_tms99XX, uint8_t mask);
+
+/***************************************************************************//**
+ * @brief   Wait for the start of vertical blank. With IRQ enabled this waits
+ *          on nINT the way set by setTMS99XXvblankWait and does not clear
+ *          it, so a transfer right after does not wait again. With IRQ
+ *          disabled the status interrupt flag is polled instead.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @return  1 at vertical blank, 0 on timeout.
+ ******************************************************************************/
+uint8_t waitTMS99XXvblank(struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Set how transfers and waitTMS99XXvblank wait for vertical blank.
+ *          Default is VBLANK_POLL with no timeout and no yield, the old busy
+ *          poll of nINT. VBLANK_EVENT waits for isrTMS99XXvblank to be called
+ *          from the application's nINT edge interrupt (INTx or interrupt on
+ *          change) with interrupts left on. VBLANK_IDLE also puts the cpu in
+ *          idle till any interrupt. It needs a periodic wake source, ex. the
+ *          vblank timer overflow interrupt, waking more often than the timer
+ *          wraps, else a dead nINT idles forever. Its timeout is measured on
+ *          the vblank timer (initTMS99XXvblankTimer), with no timer set a
+ *          VBLANK_IDLE wait with a timeout runs like VBLANK_EVENT.
+ *          A transfer that times out returns 0 bytes.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   mode VBLANK_POLL, VBLANK_EVENT or VBLANK_IDLE.
+ * @param   timeout ticks of VBLANK_TICK_US to wait, 0 waits forever.
+ * @param   p_yield function called every tick while waiting, NULL for none.
+ ******************************************************************************/
+void setTMS99XXvblankWait(struct s_tms99XX * const p_tms99XX, uint8_t mode, uint16_t timeout, void (*p_yield)(void));
+
+/***************************************************************************//**
+ * @brief   Call from the interrupt routine on the nINT falling edge. Reads
+ *          the status register, which releases nINT and latches the status
+ *          bits, and flags vertical blank for VBLANK_EVENT and VBLANK_IDLE.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ ******************************************************************************/
+void isrTMS99XXvblank(struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Give the driver a free running 16 bit timer for vblank deadlines,
+ *          ex. Timer1 in 16 bit read mode at Fosc/4 with 1:8 prescale is
+ *          1500 ticks per ms. The timer must not wrap within one frame.
+ *          Run calibrateTMS99XXvblank after this.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_timerL timer low byte, read first.
+ * @param   p_timerH timer high byte, latched by the low byte read.
+ * @param   ticksPerMs timer ticks per millisecond, a 20 ms frame has to
+ *          fit 16 bits so at most 3276.
+ * @return  1 on success, 0 if ticksPerMs is too fast, no timer is set.
+ ******************************************************************************/
+uint8_t initTMS99XXvblankTimer(struct s_tms99XX * const p_tms99XX, volatile unsigned char *p_timerL, volatile unsigned char *p_timerH, uint16_t ticksPerMs);
+
+/***************************************************************************//**
+ * @brief   Measure the frame period, tell 50 Hz from 60 Hz and work out
+ *          the blank window. Takes up to three frames with interrupts on.
+ *          In VBLANK_EVENT and VBLANK_IDLE the frames are timed by the
+ *          stamps isrTMS99XXvblank takes, so the nINT interrupt has to be
+ *          running. In VBLANK_POLL the status frame flag is polled, an
+ *          interrupt between the flag and the timer read adds its length
+ *          to that frame. After this paced transfers stop at the timer
+ *          deadline instead of VBLANK_BYTE_LIMIT bytes, and stale nINT
+ *          levels are waited out. Run again after a clock change.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @return  VIDEO_NTSC, VIDEO_PAL, or VIDEO_UNKNOWN if no frames were seen
+ *          within VBLANK_CAL_MS.
+ ******************************************************************************/
+uint8_t calibrateTMS99XXvblank(struct s_tms99XX * const p_tms99XX);
+
 /***************************************************************************//**
  * @brief   Clear all data from VRAM from 0x0000 to 0x3FFF. This will block 
  *          till it has cleared all data.
  * 
  * @param   p_tms99XX pointer to struct to contain port data.
+ * @return  1 on success, 0 if a vblank wait timed out.
  ******************************************************************************/
-void clearTMS99XXvramData(struct s_tms99XX * const p_tms99XX);
+uint8_t clearTMS99XXvramData(struct s_tms99XX * const p_tms99XX);
 
 /***************************************************************************//**
  * @brief   Test all VRAM. This will block till all data written.
  * 
  * @param   p_tms99XX pointer to struct to contain port data.
- * @return  0 for error, 1 for pass.
+ * @return  0 for error or a timed out vblank wait, 1 for pass.
  ******************************************************************************/
 uint8_t checkTMS99XXvram(struct s_tms99XX * const p_tms99XX);
 
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * @file    tms99XXanim.h
+ * @brief   Bank switched animation for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Animation by table bank switching. Registers 3, 4 and 6 point the
+ *          color, pattern and sprite pattern tables at any aligned block of
+ *          VRAM, so every frame of an animation is preloaded into its own bank
+ *          once. Showing the next frame is then one register write instead of a
+ *          table upload, ex. color cycling, animated water tiles or sprite
+ *          animation frames. Bank addresses can come from a layout planned with
+ *          more than one bank per table. The sequencer counts frames, call
+ *          stepTMS99XXanim once per frame right after the vertical blank.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_ANIM
+#define __LIB_TMS99XX_ANIM
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Setup an animation of one table. Starts with no banks, one frame
+ *          per step and the banks shown in order.
+ * 
+ * @param   p_anim pointer to struct to contain animation data.
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   table LAYOUT_COLOR, LAYOUT_PATTERN or LAYOUT_SPRITE_PATTERN.
+ ******************************************************************************/
+void initTMS99XXanim(struct s_tms99XX_anim * const p_anim, struct s_tms99XX * const p_tms99XX, uint8_t table);
+
+/***************************************************************************//**
+ * @brief   Preload a bank. The data is written to VRAM now, this is the
+ *          only upload the bank ever needs. The address must be aligned for
+ *          the table, see getTMS99XXlayoutAlign.
+ * 
+ * @param   p_anim pointer to struct to contain animation data.
+ * @param   vramAddr aligned 14 bit address of the bank.
+ * @param   p_data pointer to table data, NULL to only record the address
+ *          of a bank that is already in VRAM.
+ * @param   size number of bytes of table data.
+ * @return  bank number, ANIM_NO_BANK if full, misaligned or timed out.
+ ******************************************************************************/
+uint8_t addTMS99XXanimBank(struct s_tms99XX_anim * const p_anim, uint16_t vramAddr, void const * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Set the sequencer timing and order.
+ * 
+ * @param   p_anim pointer to struct to contain animation data.
+ * @param   framesPerStep frames each bank is shown, 0 stops the sequencer.
+ * @param   p_sequence bank numbers in show order, must stay valid, NULL to
+ *          show the banks in order.
+ * @param   numSteps number of entries in p_sequence.
+ ******************************************************************************/
+void setTMS99XXanimSequence(struct s_tms99XX_anim * const p_anim, uint8_t framesPerStep, uint8_t const * const p_sequence, uint8_t numSteps);
+
+/***************************************************************************//**
+ * @brief   Count one frame, and when the step is due point the table
+ *          register at the next bank. Call once per frame after the
+ *          vertical blank starts so the switch does not tear.
+ * 
+ * @param   p_anim pointer to struct to contain animation data.
+ * @return  1 if the register was written, 0 if not.
+ ******************************************************************************/
+uint8_t stepTMS99XXanim(struct s_tms99XX_anim * const p_anim);
+
+/***************************************************************************//**
+ * @brief   Show a bank now, one register write.
+ * 
+ * @param   p_anim pointer to struct to contain animation data.
+ * @param   bank bank number from addTMS99XXanimBank.
+ ******************************************************************************/
+void showTMS99XXanimBank(struct s_tms99XX_anim * const p_anim, uint8_t bank);
+
+#endif
@@ -40,6 +40,7 @@
 /** From TMS9918 datasheet **/
 /** Fixed a few bugs, duplicate > and bad lower case letters **/
 /** Added nulls for first 32 to pad out struct, easier to just create strings and go. **/
+/** const at file scope, xc8 keeps it in program memory. Upload with setTMS99XXvramFlashData. **/
 const union u_tms99XX_patternTable8x8 c_tms99XX_ascii[] = 
 {
   { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * @file    tms99XXbmp.h
+ * @brief   Multicolor framebuffer for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details 64x48 multicolor(bitmap) mode framebuffer kept in RAM as
+ *          packed nibbles. The name table is installed once so pattern
+ *          block n holds screen columns 2n, 2n+1 of an 8 pixel tall band.
+ *          A packed framebuffer row then is the same byte as its pattern
+ *          row, commit only gathers the changed 8 byte blocks.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_BMP
+#define __LIB_TMS99XX_BMP
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Put the VDP in multicolor mode, install the name table and clear
+ *          the framebuffer and pattern table. This will block till done.
+ * 
+ * @param   p_bmp pointer to struct to contain framebuffer data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @return  1 on success, 0 if a vblank wait timed out.
+ ******************************************************************************/
+uint8_t initTMS99XXbmp(struct s_tms99XX_bmp * const p_bmp, struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Set a single pixel in the framebuffer.
+ * 
+ * @param   p_bmp pointer to struct to contain framebuffer data.
+ * @param   x horizontal position 0 to 63.
+ * @param   y vertical position 0 to 47.
+ * @param   color 4 bit color value.
+ ******************************************************************************/
+void setTMS99XXbmpPixel(struct s_tms99XX_bmp * const p_bmp, uint8_t x, uint8_t y, uint8_t color);
+
+/***************************************************************************//**
+ * @brief   Get a single pixel from the framebuffer.
+ * 
+ * @param   p_bmp pointer to struct to contain framebuffer data.
+ * @param   x horizontal position 0 to 63.
+ * @param   y vertical position 0 to 47.
+ * @return  4 bit color value, 0 if out of range.
+ ******************************************************************************/
+uint8_t getTMS99XXbmpPixel(struct s_tms99XX_bmp * const p_bmp, uint8_t x, uint8_t y);
+
+/***************************************************************************//**
+ * @brief   Set the whole framebuffer to one color.
+ * 
+ * @param   p_bmp pointer to struct to contain framebuffer data.
+ * @param   color 4 bit color value.
+ ******************************************************************************/
+void fillTMS99XXbmp(struct s_tms99XX_bmp * const p_bmp, uint8_t color);
+
+/***************************************************************************//**
+ * @brief   Write the changed pattern blocks to VRAM. Runs of neighbouring
+ *          blocks share one address setup.
+ * 
+ * @param   p_bmp pointer to struct to contain framebuffer data.
+ * @return  1 on success, 0 if a vblank wait timed out. Blocks that did not
+ *          go out stay changed for the next commit.
+ ******************************************************************************/
+uint8_t commitTMS99XXbmp(struct s_tms99XX_bmp * const p_bmp);
+
+#endif
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * @file    tms99XXboot.h
+ * @brief   Fast boot for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Fast boot from a prebuilt VRAM image. One const image holds all 8
+ *          registers and the VRAM contents of the first screen, raw or run length
+ *          encoded so blank tables cost a few bytes of flash. The registers and
+ *          the image go out in one burst with the screen blanked, so no vblank
+ *          pacing, then the screen is turned on once with the image settings.
+ *          The VRAM self test can be skipped, cut to a quick address and data
+ *          line check for a warm reset, or run in full after power on.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_BOOT
+#define __LIB_TMS99XX_BOOT
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Boot the first screen from an image, replaces setTMS99XXmode, the
+ *          clear and every table upload after initTMS99XX. Run length data
+ *          is a control byte, bit 7 set is a run of (bits 6-0) + 1 copies of
+ *          the next byte, clear is (bits 6-0) + 1 literal bytes following.
+ *          Pick the check from the reset cause, ex. RCONbits.nPOR clear
+ *          after power on is BOOT_CHECK_FULL, else BOOT_CHECK_QUICK.
+ * 
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   p_image pointer to const image in program memory.
+ * @param   check BOOT_CHECK_NONE, BOOT_CHECK_QUICK or BOOT_CHECK_FULL.
+ * @return  1 for pass, 0 if the check failed, the image is bad or a
+ *          transfer timed out. The screen stays blanked on 0.
+ ******************************************************************************/
+uint8_t bootTMS99XX(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_bootImage const * const p_image, uint8_t check);
+
+/***************************************************************************//**
+ * @brief   Quick VRAM check, one byte on address 0 and on every address line
+ *          (0x0001 to 0x2000), each a different value. Finds stuck or
+ *          shorted address and data lines in 30 bytes of transfers instead
+ *          of 32K. The bytes it uses are left 0.
+ * 
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @return  0 for error, 1 for pass.
+ ******************************************************************************/
+uint8_t checkTMS99XXvramQuick(struct s_tms99XX * const p_tms99XX);
+
+#endif
@@ -97,6 +97,11 @@ struct s_tms99XX
    * contains current mode of the VDP
    */
   uint8_t vdpMode;
+  /**
+   * @var s_tms99XX::gfx2Thirds
+   * graphics II third sharing of the pattern and color tables.
+   */
+  uint8_t gfx2Thirds;
   /**
    * @var s_tms99XX::register0
    * register 0 contents
@@ -112,6 +117,68 @@ struct s_tms99XX
    * color sent to register 7, background/text color.
    */
   uint8_t colorReg;
+  /**
+   * @var s_tms99XX::statusLatch
+   * status register bits collected from every status read, the VDP clears
+   * them on read so they are kept here till the application asks. set by
+   * the interrupt handlers too.
+   */
+  volatile uint8_t statusLatch;
+  /**
+   * @var s_tms99XX::vblankFlag
+   * set by isrTMS99XXvblank, cleared when a transfer used the blank.
+   */
+  volatile uint8_t vblankFlag;
+  /**
+   * @var s_tms99XX::vblankMode
+   * VBLANK_POLL, VBLANK_EVENT or VBLANK_IDLE.
+   */
+  uint8_t vblankMode;
+  /**
+   * @var s_tms99XX::vblankTimeout
+   * ticks of VBLANK_TICK_US to wait for vertical blank, 0 is forever.
+   */
+  uint16_t vblankTimeout;
+  /**
+   * @var s_tms99XX::p_vblankYield
+   * called every tick while waiting for vertical blank, NULL for none.
+   */
+  void (*p_vblankYield)(void);
+  /**
+   * @var s_tms99XX::p_timerL
+   * low byte of a free running 16 bit timer, NULL for none.
+   */
+  volatile unsigned char *p_timerL;
+  /**
+   * @var s_tms99XX::p_timerH
+   * high byte of the timer, latched when the low byte is read.
+   */
+  volatile unsigned char *p_timerH;
+  /**
+   * @var s_tms99XX::timerTicksPerMs
+   * timer ticks per millisecond, used to tell 50 Hz from 60 Hz.
+   */
+  uint16_t timerTicksPerMs;
+  /**
+   * @var s_tms99XX::framePeriod
+   * measured frame period in timer ticks, 0 if not calibrated.
+   */
+  uint16_t framePeriod;
+  /**
+   * @var s_tms99XX::blankWindow
+   * timer ticks from the nINT edge a transfer may run, 0 if not calibrated.
+   */
+  uint16_t blankWindow;
+  /**
+   * @var s_tms99XX::vblankStamp
+   * timer value at the start of the last vertical blank.
+   */
+  volatile uint16_t vblankStamp;
+  /**
+   * @var s_tms99XX::videoStandard
+   * VIDEO_UNKNOWN, VIDEO_NTSC or VIDEO_PAL.
+   */
+  uint8_t videoStandard;
   /**
    * @var s_tms99XX::nCSR
    * active low read enable pin number
@@ -137,6 +204,72 @@ struct s_tms99XX
    * active low interrupt pin number
    */
   uint8_t nINT;
+  /**
+   * @var s_tms99XX::nCSRmask
+   * control port mask of nCSR.
+   */
+  uint8_t nCSRmask;
+  /**
+   * @var s_tms99XX::nCSWmask
+   * control port mask of nCSW, a group broadcast has one bit per chip.
+   */
+  uint8_t nCSWmask;
+  /**
+   * @var s_tms99XX::modeMask
+   * control port mask of mode.
+   */
+  uint8_t modeMask;
+  /**
+   * @var s_tms99XX::nresetMask
+   * control port mask of nreset, a group broadcast has one bit per chip.
+   */
+  uint8_t nresetMask;
+  /**
+   * @var s_tms99XX::ctrlShadow
+   * image of the control port latch, pins change with one port write.
+   */
+  uint8_t ctrlShadow;
+  /**
+   * @var s_tms99XX::busDir
+   * cached data bus direction, BUS_INPUT, BUS_OUTPUT or BUS_UNKNOWN.
+   */
+  uint8_t busDir;
+  /**
+   * @var s_tms99XX::modeLevel
+   * cached level of the mode pin, 0, 1 or BUS_UNKNOWN.
+   */
+  uint8_t modeLevel;
+  /**
+   * @var s_tms99XX::vramAddr
+   * vram address the next data transfer uses, tracked for mirrors.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX::vramAddrState
+   * VRAM_ADDR_SYNC, VRAM_ADDR_LAG or VRAM_ADDR_UNKNOWN, isrTMS99XXreg
+   * changes it.
+   */
+  volatile uint8_t vramAddrState;
+  /**
+   * @var s_tms99XX::vramAddrRead
+   * 1 if the vdp address was last set for reading.
+   */
+  uint8_t vramAddrRead;
+  /**
+   * @var s_tms99XX::p_mirrors
+   * list of vram regions mirrored in RAM, NULL for none.
+   */
+  struct s_tms99XX_mirror *p_mirrors;
+  /**
+   * @var s_tms99XX::p_uploadCache
+   * table of resident uploads, NULL for none.
+   */
+  struct s_tms99XX_uploadCache *p_uploadCache;
+  /**
+   * @var s_tms99XX::p_combine
+   * write combine buffer, NULL for none.
+   */
+  struct s_tms99XX_combine *p_combine;
 };
 
 /**
@@ -334,4 +467,929 @@ union u_tms99XX_spriteAttributeTable
   uint8_t data[4];
 };
 
+/**
+ * @struct s_tms99XX_gfx2Cell
+ * @brief Struct for containing the cached pattern or color bytes of a
+ *        graphics II 8x8 cell
+ */
+struct s_tms99XX_gfx2Cell
+{
+  /**
+   * @var s_tms99XX_gfx2Cell::vramAddr
+   * vram address of the 8 bytes, after third sharing. Screen cells that
+   * read the same table bytes share one entry.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_gfx2Cell::data
+   * 8 pattern or color bytes of the cell, one per pixel row.
+   */
+  uint8_t data[8];
+  /**
+   * @var s_tms99XX_gfx2Cell::dirty
+   * 1 if data needs to be written to VRAM.
+   */
+  uint8_t dirty;
+};
+
+/**
+ * @struct s_tms99XX_gfx2
+ * @brief Struct for containing a graphics II bitmap drawing instance
+ */
+struct s_tms99XX_gfx2
+{
+  /**
+   * @var s_tms99XX_gfx2::p_tms99XX
+   * VDP the bitmap is drawn on.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_gfx2::cells
+   * cells touched since the last commit.
+   */
+  struct s_tms99XX_gfx2Cell cells[GFX2_CACHE_CELLS];
+  /**
+   * @var s_tms99XX_gfx2::numCells
+   * number of cells in use.
+   */
+  uint8_t numCells;
+  /**
+   * @var s_tms99XX_gfx2::color
+   * draw color, foreground upper nibble, background lower nibble.
+   */
+  uint8_t color;
+  /**
+   * @var s_tms99XX_gfx2::blankColor
+   * color table byte init wrote.
+   */
+  uint8_t blankColor;
+  /**
+   * @var s_tms99XX_gfx2::drawn
+   * one bit per table cell, set once it may differ from what init wrote.
+   */
+  uint8_t drawn[GFX2_TABLE_SIZE / 64];
+};
+
+/**
+ * @struct s_tms99XX_bmp
+ * @brief Struct for containing a multicolor mode framebuffer
+ */
+struct s_tms99XX_bmp
+{
+  /**
+   * @var s_tms99XX_bmp::p_tms99XX
+   * VDP the framebuffer is shown on.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_bmp::pixels
+   * 64x48 pixels, 32 bytes a row, left pixel in the upper nibble.
+   */
+  uint8_t pixels[BMP_FRAME_SIZE];
+  /**
+   * @var s_tms99XX_bmp::dirty
+   * one bit per pattern block changed since the last commit.
+   */
+  uint8_t dirty[BMP_BLOCKS / 8];
+};
+
+/**
+ * @struct s_tms99XX_spriteMux
+ * @brief Struct for containing a sprite manager that multiplexes sprites over
+ *        the 4 sprites per scanline limit.
+ */
+struct s_tms99XX_spriteMux
+{
+  /**
+   * @var s_tms99XX_spriteMux::p_tms99XX
+   * VDP the sprites are shown on.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_spriteMux::p_sprites
+   * application sprite attributes, in application priority order.
+   */
+  union u_tms99XX_spriteAttributeTable *p_sprites;
+  /**
+   * @var s_tms99XX_spriteMux::numSprites
+   * number of sprites in p_sprites, 0 to 32.
+   */
+  uint8_t numSprites;
+  /**
+   * @var s_tms99XX_spriteMux::rotate
+   * sprite written to attribute slot 0 on the next overloaded frame.
+   */
+  uint8_t rotate;
+  /**
+   * @var s_tms99XX_spriteMux::maxPerLine
+   * most sprites found on one scanline by the last update.
+   */
+  uint8_t maxPerLine;
+  /**
+   * @var s_tms99XX_spriteMux::lineCount
+   * sprites on each scanline, work space of the update.
+   */
+  uint8_t lineCount[SCREEN_LINES];
+  /**
+   * @var s_tms99XX_spriteMux::buffer
+   * attribute table and terminator as written, work space of the update.
+   */
+  uint8_t buffer[SPRITE_ATTRIBUTE_TABLE_SIZE + 1];
+};
+
+/**
+ * @struct s_tms99XX_spritePair
+ * @brief Struct for containing two colliding sprites
+ */
+struct s_tms99XX_spritePair
+{
+  /**
+   * @var s_tms99XX_spritePair::first
+   * lower sprite number (index into the application sprite array).
+   */
+  uint8_t first;
+  /**
+   * @var s_tms99XX_spritePair::second
+   * higher sprite number (index into the application sprite array).
+   */
+  uint8_t second;
+};
+
+/**
+ * @struct s_tms99XX_vramRegion
+ * @brief Struct for containing a region of VRAM
+ */
+struct s_tms99XX_vramRegion
+{
+  /**
+   * @var s_tms99XX_vramRegion::addr
+   * start address of the region.
+   */
+  uint16_t addr;
+  /**
+   * @var s_tms99XX_vramRegion::size
+   * size of the region in bytes.
+   */
+  uint16_t size;
+};
+
+/**
+ * @struct s_tms99XX_layout
+ * @brief Struct for containing a planned VRAM table layout
+ */
+struct s_tms99XX_layout
+{
+  /**
+   * @var s_tms99XX_layout::vdpMode
+   * mode the layout is planned for.
+   */
+  uint8_t vdpMode;
+  /**
+   * @var s_tms99XX_layout::gfx2Thirds
+   * graphics II third sharing the pattern and color tables are sized for.
+   */
+  uint8_t gfx2Thirds;
+  /**
+   * @var s_tms99XX_layout::numBanks
+   * copies wanted of each table, index with LAYOUT_NAME and friends. 0 for
+   * tables the mode does not use.
+   */
+  uint8_t numBanks[LAYOUT_TABLES];
+  /**
+   * @var s_tms99XX_layout::size
+   * bytes used by each table, defaults to the mode size. Can be lowered
+   * before planning, ex. only 16 sprite patterns are used.
+   */
+  uint16_t size[LAYOUT_TABLES];
+  /**
+   * @var s_tms99XX_layout::addr
+   * planned address of each bank of each table, bank 0 is the one applied.
+   */
+  uint16_t addr[LAYOUT_TABLES][LAYOUT_MAX_BANKS];
+  /**
+   * @var s_tms99XX_layout::freeRegions
+   * VRAM left over after planning.
+   */
+  struct s_tms99XX_vramRegion freeRegions[LAYOUT_MAX_FREE];
+  /**
+   * @var s_tms99XX_layout::numFree
+   * number of free regions found.
+   */
+  uint8_t numFree;
+};
+
+/**
+ * @struct s_tms99XX_pageFlip
+ * @brief Struct for containing two name table and sprite attribute table pages
+ */
+struct s_tms99XX_pageFlip
+{
+  /**
+   * @var s_tms99XX_pageFlip::nameAddr
+   * name table address of page 0 and page 1.
+   */
+  uint16_t nameAddr[2];
+  /**
+   * @var s_tms99XX_pageFlip::spriteAttributeAddr
+   * sprite attribute table address of page 0 and page 1.
+   */
+  uint16_t spriteAttributeAddr[2];
+  /**
+   * @var s_tms99XX_pageFlip::front
+   * page the VDP is showing, 0 or 1.
+   */
+  uint8_t front;
+  /**
+   * @var s_tms99XX_pageFlip::syncOffset
+   * bytes of the front page copied to the back page so far.
+   */
+  uint16_t syncOffset;
+  /**
+   * @var s_tms99XX_pageFlip::syncSize
+   * bytes left to copy from the front page to the back page, 0 when synced.
+   */
+  uint16_t syncSize;
+};
+
+/**
+ * @struct s_tms99XX_tile
+ * @brief Struct for containing a tile as stored in flash
+ */
+struct s_tms99XX_tile
+{
+  /**
+   * @var s_tms99XX_tile::pattern
+   * 8x8 pattern of the tile.
+   */
+  union u_tms99XX_patternTable8x8 pattern;
+  /**
+   * @var s_tms99XX_tile::color
+   * graphics I color of the tile, shared by the 8 patterns of a color group.
+   */
+  union u_tms99XX_colorTable color;
+};
+
+/**
+ * @struct s_tms99XX_tileCache
+ * @brief Struct for containing a LRU cache of tiles in the pattern table
+ */
+struct s_tms99XX_tileCache
+{
+  /**
+   * @var s_tms99XX_tileCache::p_tms99XX
+   * VDP the tiles are loaded to.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_tileCache::p_tiles
+   * all tiles, indexed by tile id.
+   */
+  struct s_tms99XX_tile const *p_tiles;
+  /**
+   * @var s_tms99XX_tileCache::numTiles
+   * number of tiles in p_tiles.
+   */
+  uint16_t numTiles;
+  /**
+   * @var s_tms99XX_tileCache::firstSlot
+   * first pattern number used by the cache.
+   */
+  uint8_t firstSlot;
+  /**
+   * @var s_tms99XX_tileCache::numSlots
+   * number of pattern numbers used by the cache.
+   */
+  uint8_t numSlots;
+  /**
+   * @var s_tms99XX_tileCache::tileId
+   * tile loaded in each slot, TILE_NONE if empty.
+   */
+  uint16_t tileId[TILE_CACHE_SLOTS];
+  /**
+   * @var s_tms99XX_tileCache::lastUse
+   * clock value of the last request for each slot.
+   */
+  uint16_t lastUse[TILE_CACHE_SLOTS];
+  /**
+   * @var s_tms99XX_tileCache::groupColor
+   * graphics I color byte loaded for each group of 8 slots.
+   */
+  uint8_t groupColor[TILE_CACHE_SLOTS / 8];
+  /**
+   * @var s_tms99XX_tileCache::groupValid
+   * one bit per group of 8 slots, set once its color byte is written.
+   */
+  uint32_t groupValid;
+  /**
+   * @var s_tms99XX_tileCache::clock
+   * request counter used for least recently used.
+   */
+  uint16_t clock;
+  /**
+   * @var s_tms99XX_tileCache::hits
+   * requests found loaded.
+   */
+  uint32_t hits;
+  /**
+   * @var s_tms99XX_tileCache::misses
+   * requests that needed an upload.
+   */
+  uint32_t misses;
+  /**
+   * @var s_tms99XX_tileCache::evictions
+   * loaded tiles thrown out to make room.
+   */
+  uint32_t evictions;
+};
+
+/**
+ * @struct s_tms99XX_group
+ * @brief Struct for containing VDPs that share a data bus and mode line
+ */
+struct s_tms99XX_group
+{
+  /**
+   * @var s_tms99XX_group::p_chips
+   * every VDP of the group, chip 0 is the master that paces transfers.
+   */
+  struct s_tms99XX *p_chips[GROUP_MAX_CHIPS];
+  /**
+   * @var s_tms99XX_group::numChips
+   * number of VDPs in the group.
+   */
+  uint8_t numChips;
+  /**
+   * @var s_tms99XX_group::broadcast
+   * VDP struct whose nCSW and nreset masks hold every chip of the group,
+   * writes through it reach all chips in one bus transfer.
+   */
+  struct s_tms99XX broadcast;
+};
+
+/**
+ * @struct s_tms99XX_step
+ * @brief Struct for containing a step-wise VRAM operation
+ */
+struct s_tms99XX_step
+{
+  /**
+   * @var s_tms99XX_step::p_tms99XX
+   * VDP the operation runs on.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_step::p_data
+   * data to write, NULL writes fillData instead.
+   */
+  uint8_t const *p_data;
+  /**
+   * @var s_tms99XX_step::vramAddr
+   * vram address the operation starts at.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_step::size
+   * number of bytes the operation covers.
+   */
+  uint16_t size;
+  /**
+   * @var s_tms99XX_step::index
+   * bytes of the current phase done.
+   */
+  uint16_t index;
+  /**
+   * @var s_tms99XX_step::fillData
+   * byte written, and checked, when there is no data pointer.
+   */
+  uint8_t fillData;
+  /**
+   * @var s_tms99XX_step::verify
+   * 1 to read back and check fillData after writing.
+   */
+  uint8_t verify;
+  /**
+   * @var s_tms99XX_step::phase
+   * STEP_PHASE_WRITE or STEP_PHASE_VERIFY.
+   */
+  uint8_t phase;
+  /**
+   * @var s_tms99XX_step::state
+   * STEP_IDLE, STEP_BUSY, STEP_DONE or STEP_FAIL.
+   */
+  uint8_t state;
+};
+
+/**
+ * @struct s_tms99XX_mirror
+ * @brief Struct for containing a vram region mirrored in RAM
+ */
+struct s_tms99XX_mirror
+{
+  /**
+   * @var s_tms99XX_mirror::p_next
+   * next mirror of the same vdp, NULL at the end.
+   */
+  struct s_tms99XX_mirror *p_next;
+  /**
+   * @var s_tms99XX_mirror::p_buffer
+   * RAM copy of the region, size bytes.
+   */
+  uint8_t *p_buffer;
+  /**
+   * @var s_tms99XX_mirror::vramAddr
+   * vram address of the start of the region.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_mirror::size
+   * number of bytes in the region.
+   */
+  uint16_t size;
+  /**
+   * @var s_tms99XX_mirror::valid
+   * 1 when the buffer matches vram.
+   */
+  uint8_t valid;
+  /**
+   * @var s_tms99XX_mirror::bytesLocal
+   * bytes of reads served from the buffer.
+   */
+  uint32_t bytesLocal;
+  /**
+   * @var s_tms99XX_mirror::bytesWrote
+   * bytes of writes copied through to the buffer.
+   */
+  uint32_t bytesWrote;
+};
+
+/**
+ * @struct s_tms99XX_upload
+ * @brief Struct for containing a vram range and the hash of its contents
+ */
+struct s_tms99XX_upload
+{
+  /**
+   * @var s_tms99XX_upload::vramAddr
+   * start of the upload in vram.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_upload::size
+   * size of the upload in bytes, 0 if the entry is empty.
+   */
+  uint16_t size;
+  /**
+   * @var s_tms99XX_upload::hash
+   * hash of the uploaded data.
+   */
+  uint16_t hash;
+};
+
+/**
+ * @struct s_tms99XX_uploadCache
+ * @brief Struct for containing uploads known to still be in vram
+ */
+struct s_tms99XX_uploadCache
+{
+  /**
+   * @var s_tms99XX_uploadCache::uploads
+   * resident uploads.
+   */
+  struct s_tms99XX_upload uploads[UPLOAD_CACHE_ENTRIES];
+  /**
+   * @var s_tms99XX_uploadCache::next
+   * entry replaced when none is empty.
+   */
+  uint8_t next;
+  /**
+   * @var s_tms99XX_uploadCache::hits
+   * uploads skipped, data was already resident.
+   */
+  uint32_t hits;
+  /**
+   * @var s_tms99XX_uploadCache::misses
+   * uploads sent to vram.
+   */
+  uint32_t misses;
+};
+
+/**
+ * @struct s_tms99XX_anim
+ * @brief Struct for containing a bank switched table animation
+ */
+struct s_tms99XX_anim
+{
+  /**
+   * @var s_tms99XX_anim::p_tms99XX
+   * VDP the animation runs on.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_anim::p_sequence
+   * bank numbers in show order, NULL for bank order.
+   */
+  uint8_t const *p_sequence;
+  /**
+   * @var s_tms99XX_anim::bankAddr
+   * vram address of each bank.
+   */
+  uint16_t bankAddr[ANIM_MAX_BANKS];
+  /**
+   * @var s_tms99XX_anim::table
+   * LAYOUT_COLOR, LAYOUT_PATTERN or LAYOUT_SPRITE_PATTERN.
+   */
+  uint8_t table;
+  /**
+   * @var s_tms99XX_anim::numBanks
+   * number of banks loaded.
+   */
+  uint8_t numBanks;
+  /**
+   * @var s_tms99XX_anim::numSteps
+   * number of entries in p_sequence.
+   */
+  uint8_t numSteps;
+  /**
+   * @var s_tms99XX_anim::step
+   * current step of the sequence.
+   */
+  uint8_t step;
+  /**
+   * @var s_tms99XX_anim::framesPerStep
+   * frames each bank is shown, 0 is stopped.
+   */
+  uint8_t framesPerStep;
+  /**
+   * @var s_tms99XX_anim::frameCount
+   * frames the current bank has been shown.
+   */
+  uint8_t frameCount;
+};
+
+/**
+ * @struct s_tms99XX_storePage
+ * @brief Struct for containing a RAM copy of a store page
+ */
+struct s_tms99XX_storePage
+{
+  /**
+   * @var s_tms99XX_storePage::data
+   * page contents.
+   */
+  uint8_t data[STORE_PAGE_SIZE];
+  /**
+   * @var s_tms99XX_storePage::vramAddr
+   * vram address of the page, STORE_NO_PAGE if empty.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_storePage::lastUse
+   * clock value of the last access.
+   */
+  uint16_t lastUse;
+  /**
+   * @var s_tms99XX_storePage::dirty
+   * 1 if data has writes not in vram yet.
+   */
+  uint8_t dirty;
+};
+
+/**
+ * @struct s_tms99XX_store
+ * @brief Struct for containing VRAM paged storage
+ */
+struct s_tms99XX_store
+{
+  /**
+   * @var s_tms99XX_store::p_tms99XX
+   * VDP the store lives in.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_store::freeMap
+   * one bit per vram page, set if the page is free.
+   */
+  uint8_t freeMap[STORE_PAGES / 8];
+  /**
+   * @var s_tms99XX_store::buffers
+   * vram region of each handle, size 0 if the handle is unused.
+   */
+  struct s_tms99XX_vramRegion buffers[STORE_MAX_HANDLES];
+  /**
+   * @var s_tms99XX_store::pages
+   * RAM page cache.
+   */
+  struct s_tms99XX_storePage pages[STORE_CACHE_PAGES];
+  /**
+   * @var s_tms99XX_store::clock
+   * access counter used for least recently used.
+   */
+  uint16_t clock;
+  /**
+   * @var s_tms99XX_store::hits
+   * page accesses found cached.
+   */
+  uint32_t hits;
+  /**
+   * @var s_tms99XX_store::misses
+   * page accesses that needed a page loaded.
+   */
+  uint32_t misses;
+  /**
+   * @var s_tms99XX_store::writeBacks
+   * dirty pages written to vram.
+   */
+  uint32_t writeBacks;
+};
+
+/**
+ * @struct s_tms99XX_fifo
+ * @brief Struct for containing a FIFO ring buffer in VRAM
+ */
+struct s_tms99XX_fifo
+{
+  /**
+   * @var s_tms99XX_fifo::p_tms99XX
+   * VDP the ring lives in.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_fifo::vramAddr
+   * start of the ring in vram.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_fifo::size
+   * size of the ring in bytes.
+   */
+  uint16_t size;
+  /**
+   * @var s_tms99XX_fifo::head
+   * ring offset the next batch is written to.
+   */
+  uint16_t head;
+  /**
+   * @var s_tms99XX_fifo::tail
+   * ring offset the next batch is read from.
+   */
+  uint16_t tail;
+  /**
+   * @var s_tms99XX_fifo::vramCount
+   * number of bytes in the ring.
+   */
+  uint16_t vramCount;
+  /**
+   * @var s_tms99XX_fifo::p_pushStage
+   * newest bytes, not in vram yet, caller buffer of stageSize bytes.
+   */
+  uint8_t *p_pushStage;
+  /**
+   * @var s_tms99XX_fifo::pushCount
+   * number of bytes in p_pushStage.
+   */
+  uint16_t pushCount;
+  /**
+   * @var s_tms99XX_fifo::p_popStage
+   * oldest bytes, read from vram, caller buffer of stageSize bytes.
+   */
+  uint8_t *p_popStage;
+  /**
+   * @var s_tms99XX_fifo::popIndex
+   * next byte of p_popStage to pop.
+   */
+  uint16_t popIndex;
+  /**
+   * @var s_tms99XX_fifo::popCount
+   * number of bytes in p_popStage.
+   */
+  uint16_t popCount;
+  /**
+   * @var s_tms99XX_fifo::stageSize
+   * bytes of each stage, the most one batch moves.
+   */
+  uint16_t stageSize;
+};
+
+/**
+ * @struct s_tms99XX_bootImage
+ * @brief Struct for containing a boot image, registers and VRAM contents
+ */
+struct s_tms99XX_bootImage
+{
+  /**
+   * @var s_tms99XX_bootImage::registers
+   * register 0 to 7 values.
+   */
+  uint8_t registers[8];
+  /**
+   * @var s_tms99XX_bootImage::p_data
+   * vram contents in program memory, raw or run length encoded.
+   */
+  uint8_t const *p_data;
+  /**
+   * @var s_tms99XX_bootImage::size
+   * size of p_data in bytes.
+   */
+  uint16_t size;
+  /**
+   * @var s_tms99XX_bootImage::vramAddr
+   * address the vram contents start at.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_bootImage::rle
+   * 1 if p_data is run length encoded, 0 for raw.
+   */
+  uint8_t rle;
+};
+
+/**
+ * @struct s_tms99XX_asset
+ * @brief Struct for containing a block of const data a display list copies
+ */
+struct s_tms99XX_asset
+{
+  /**
+   * @var s_tms99XX_asset::p_data
+   * data in program memory.
+   */
+  uint8_t const *p_data;
+  /**
+   * @var s_tms99XX_asset::size
+   * size of p_data in bytes.
+   */
+  uint16_t size;
+};
+
+/**
+ * @struct s_tms99XX_combine
+ * @brief Struct for containing small writes combined into one transfer
+ */
+struct s_tms99XX_combine
+{
+  /**
+   * @var s_tms99XX_combine::buffer
+   * bytes waiting to be written.
+   */
+  uint8_t buffer[COMBINE_BUFFER_SIZE];
+  /**
+   * @var s_tms99XX_combine::vramAddr
+   * vram address of buffer[0].
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_combine::count
+   * number of bytes in buffer.
+   */
+  uint8_t count;
+  /**
+   * @var s_tms99XX_combine::writes
+   * writes added to the buffer.
+   */
+  uint32_t writes;
+  /**
+   * @var s_tms99XX_combine::bursts
+   * transfers the buffer went out in.
+   */
+  uint32_t bursts;
+};
+
+/**
+ * @struct s_tms99XX_profileAsset
+ * @brief Struct for containing a block a mode profile needs in vram
+ */
+struct s_tms99XX_profileAsset
+{
+  /**
+   * @var s_tms99XX_profileAsset::p_data
+   * data in program memory.
+   */
+  uint8_t const *p_data;
+  /**
+   * @var s_tms99XX_profileAsset::vramAddr
+   * vram address the block goes to.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_profileAsset::size
+   * size of p_data in bytes.
+   */
+  uint16_t size;
+  /**
+   * @var s_tms99XX_profileAsset::hash
+   * hash of p_data, taken once when the asset is added.
+   */
+  uint16_t hash;
+};
+
+/**
+ * @struct s_tms99XX_profile
+ * @brief Struct for containing a saved mode, its registers, tables and assets
+ */
+struct s_tms99XX_profile
+{
+  /**
+   * @var s_tms99XX_profile::registers
+   * register 0 to 7 values written on a switch, the mode and table
+   * addresses are worked out from them.
+   */
+  uint8_t registers[8];
+  /**
+   * @var s_tms99XX_profile::assets
+   * blocks the profile needs resident.
+   */
+  struct s_tms99XX_profileAsset assets[PROFILE_MAX_ASSETS];
+  /**
+   * @var s_tms99XX_profile::numAssets
+   * number of assets.
+   */
+  uint8_t numAssets;
+  /**
+   * @var s_tms99XX_profile::resident
+   * switches that only wrote registers.
+   */
+  uint32_t resident;
+  /**
+   * @var s_tms99XX_profile::reloads
+   * switches that had to upload assets.
+   */
+  uint32_t reloads;
+};
+
+/**
+ * @struct s_tms99XX_rasterEntry
+ * @brief Struct for containing one register change at a scanline
+ */
+struct s_tms99XX_rasterEntry
+{
+  /**
+   * @var s_tms99XX_rasterEntry::scanline
+   * active display line 0 to 191 the change is made at.
+   */
+  uint8_t scanline;
+  /**
+   * @var s_tms99XX_rasterEntry::regNum
+   * register to write.
+   */
+  uint8_t regNum;
+  /**
+   * @var s_tms99XX_rasterEntry::value
+   * value to write.
+   */
+  uint8_t value;
+};
+
+/**
+ * @struct s_tms99XX_raster
+ * @brief Struct for containing register changes fired by a timer each frame
+ */
+struct s_tms99XX_raster
+{
+  /**
+   * @var s_tms99XX_raster::p_tms99XX
+   * vdp the registers are written to, its vblank timer is the reference.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XX_raster::p_compareL
+   * compare register low byte on the vblank timer.
+   */
+  volatile unsigned char *p_compareL;
+  /**
+   * @var s_tms99XX_raster::p_compareH
+   * compare register high byte on the vblank timer.
+   */
+  volatile unsigned char *p_compareH;
+  /**
+   * @var s_tms99XX_raster::entries
+   * changes in scanline order.
+   */
+  struct s_tms99XX_rasterEntry entries[RASTER_MAX_ENTRIES];
+  /**
+   * @var s_tms99XX_raster::ticks
+   * timer ticks from the vblank stamp to each entry.
+   */
+  uint16_t ticks[RASTER_MAX_ENTRIES];
+  /**
+   * @var s_tms99XX_raster::numEntries
+   * number of entries, 0 stops the scheduler.
+   */
+  volatile uint8_t numEntries;
+  /**
+   * @var s_tms99XX_raster::next
+   * next entry to fire this frame.
+   */
+  volatile uint8_t next;
+  /**
+   * @var s_tms99XX_raster::stamp
+   * vblank stamp of the frame being drawn.
+   */
+  uint16_t stamp;
+  /**
+   * @var s_tms99XX_raster::late
+   * entries fired after their time had already passed.
+   */
+  uint32_t late;
+};
+
 #endif
@@ -127,6 +127,113 @@
  */
 #define REGISTER_7 7
 
+/** status register bit defines **/
+/**
+ * @def STATUS_INT_BIT
+ * interrupt flag, set at the end of the last active display line
+ */
+#define STATUS_INT_BIT 7
+/**
+ * @def STATUS_5S_BIT
+ * fifth sprite flag, more than 4 sprites on a line
+ */
+#define STATUS_5S_BIT 6
+/**
+ * @def STATUS_COL_BIT
+ * coincidence flag, two sprites have overlapping pixels
+ */
+#define STATUS_COL_BIT 5
+/**
+ * @def STATUS_5S_NUM_MASK
+ * number of the fifth sprite on a line
+ */
+#define STATUS_5S_NUM_MASK 0x1F
+
+/** VBLANK DEADLINE DEFINES **/
+/**
+ * @def VBLANK_BYTE_LIMIT
+ * bytes per blank without a calibrated timer, fits a 60 Hz blank at 48 MHz
+ */
+#ifndef VBLANK_BYTE_LIMIT
+#define VBLANK_BYTE_LIMIT 1000
+#endif
+/**
+ * @def VBLANK_MARGIN_LINES
+ * lines of the blank kept free for the last byte and loop overhead
+ */
+#ifndef VBLANK_MARGIN_LINES
+#define VBLANK_MARGIN_LINES 4
+#endif
+/**
+ * @def VBLANK_CAL_MS
+ * milliseconds to wait for three frames before calibration gives up
+ */
+#define VBLANK_CAL_MS 100
+/**
+ * @def NTSC_LINES
+ * lines per frame of the 60 Hz TMS9918/28
+ */
+#define NTSC_LINES 262
+/**
+ * @def PAL_LINES
+ * lines per frame of the 50 Hz TMS9929
+ */
+#define PAL_LINES 313
+/**
+ * @def VIDEO_UNKNOWN
+ * not calibrated
+ */
+#define VIDEO_UNKNOWN 0
+/**
+ * @def VIDEO_NTSC
+ * 60 Hz frames
+ */
+#define VIDEO_NTSC 1
+/**
+ * @def VIDEO_PAL
+ * 50 Hz frames
+ */
+#define VIDEO_PAL 2
+
+/** BUS STATE DEFINES **/
+/**
+ * @def BUS_INPUT
+ * data bus is input, TRIS all ones
+ */
+#define BUS_INPUT 0
+/**
+ * @def BUS_OUTPUT
+ * data bus is output, TRIS all zeros
+ */
+#define BUS_OUTPUT 1
+/**
+ * @def BUS_UNKNOWN
+ * cached bus direction or mode level is stale, next access writes it
+ */
+#define BUS_UNKNOWN 0xFF
+
+/** VBLANK WAIT DEFINES **/
+/**
+ * @def VBLANK_POLL
+ * busy poll the nINT pin
+ */
+#define VBLANK_POLL 0
+/**
+ * @def VBLANK_EVENT
+ * wait for isrTMS99XXvblank to flag the nINT edge
+ */
+#define VBLANK_EVENT 1
+/**
+ * @def VBLANK_IDLE
+ * wait for isrTMS99XXvblank with the cpu in idle mode
+ */
+#define VBLANK_IDLE 2
+/**
+ * @def VBLANK_TICK_US
+ * microseconds per vertical blank timeout tick
+ */
+#define VBLANK_TICK_US 10
+
 /** VRAM ADDRESS DEFINES **/
 /**
  * @def NAME_TABLE_ADDR
@@ -144,7 +251,8 @@
  * default address for color table (R3 * 0x40[2^6])
  * 0x2000 address is set when R3 is 0x80.
  * 
- * GFXII can only be 0x0000(0x7F) or 0x2000(0xFF) Init takes care of this, but
+ * GFXII can only be 0x0000(0x7F) or 0x2000(0xFF) with full thirds, see
+ * setTMS99XXgfx2Thirds for the other masks. Init takes care of this, but
  * this can be easily broken if a bad address is used for the color table.
  */
 #define COLOR_TABLE_ADDR 0x2000
@@ -158,7 +266,8 @@
  * default address for pattern table (R4 * 0x800[2^11])
  * 0x0000 address is set when R4 is 0x00
  * 
- * GFXII can only be 0x0000(0x03) or 0x2000(0x07) Init takes care of this, but 
+ * GFXII can only be 0x0000(0x03) or 0x2000(0x07) with full thirds, see
+ * setTMS99XXgfx2Thirds for the other masks. Init takes care of this, but 
  * this can be easily broken if a bad address is used for the pattern table.
  */
 #define PATTERN_TABLE_ADDR 0x0000
@@ -279,10 +388,638 @@
  */
 #define MEM_SIZE (1 << 14)
 
+/**
+ * @def NAME_TABLE_SIZE
+ * bytes in the name table for graphics I, II and bitmap modes (32x24)
+ */
+#define NAME_TABLE_SIZE 768
+
+/**
+ * @def TXT_NAME_TABLE_SIZE
+ * bytes in the name table for text mode (40x24)
+ */
+#define TXT_NAME_TABLE_SIZE 960
+
 /**
  * @def SPRITE_TERM
  * Vertical field can contain a terminator value of 0xD0 to stop sprite processing.
  */
 #define SPRITE_TERM 0xD0
 
+/** GFX II BITMAP DEFINES **/
+/**
+ * @def GFX2_WIDTH
+ * width of the graphics II bitmap in pixels
+ */
+#define GFX2_WIDTH 256
+/**
+ * @def GFX2_HEIGHT
+ * height of the graphics II bitmap in pixels
+ */
+#define GFX2_HEIGHT 192
+/**
+ * @def GFX2_TABLE_SIZE
+ * size of the graphics II pattern and color tables (3 thirds of 2K)
+ */
+#define GFX2_TABLE_SIZE 0x1800
+/**
+ * @def GFX2_THIRD_SIZE
+ * size of one third of the graphics II pattern and color tables
+ */
+#define GFX2_THIRD_SIZE 0x0800
+/**
+ * @def GFX2_THIRDS_FULL
+ * every screen third has its own pattern and color table (R3 0x7F, R4 0x03)
+ */
+#define GFX2_THIRDS_FULL 0
+/**
+ * @def GFX2_THIRDS_SHARED
+ * all screen thirds share the first pattern and color table (R3 0x1F, R4 0x00)
+ */
+#define GFX2_THIRDS_SHARED 1
+/**
+ * @def GFX2_THIRDS_MIXED
+ * all screen thirds share the first pattern table, colors per third (R3 0x7F, R4 0x00)
+ */
+#define GFX2_THIRDS_MIXED 2
+/**
+ * @def GFX2_THIRDS_HYBRID
+ * top two thirds share the first tables for text, bottom third has its own
+ * tables for a bitmap (R3 0x5F, R4 0x02)
+ */
+#define GFX2_THIRDS_HYBRID 3
+/**
+ * @def GFX2_CACHE_CELLS
+ * number of 8 byte pattern or color cells held in RAM before a commit is
+ * forced, a set pixel uses one of each. Each cell costs 11 bytes of RAM.
+ */
+#ifndef GFX2_CACHE_CELLS
+#define GFX2_CACHE_CELLS 24
+#endif
+
+/** MULTICOLOR FRAMEBUFFER DEFINES **/
+/**
+ * @def BMP_WIDTH
+ * width of the multicolor framebuffer in pixels
+ */
+#define BMP_WIDTH 64
+/**
+ * @def BMP_HEIGHT
+ * height of the multicolor framebuffer in pixels
+ */
+#define BMP_HEIGHT 48
+/**
+ * @def BMP_FRAME_SIZE
+ * bytes in the packed nibble framebuffer, also the pattern table size
+ */
+#define BMP_FRAME_SIZE ((BMP_WIDTH * BMP_HEIGHT) / 2)
+/**
+ * @def BMP_BLOCKS
+ * number of 8 byte pattern blocks in the pattern table
+ */
+#define BMP_BLOCKS (BMP_FRAME_SIZE / 8)
+
+/** SPRITE MANAGER DEFINES **/
+/**
+ * @def SPRITE_MAX
+ * number of sprites in the sprite attribute table
+ */
+#define SPRITE_MAX 32
+/**
+ * @def SPRITE_LINE_LIMIT
+ * sprites the VDP will display on one scanline
+ */
+#define SPRITE_LINE_LIMIT 4
+/**
+ * @def SPRITE_MUX_FAIL
+ * updateTMS99XXspriteMux could not write the attribute table
+ */
+#define SPRITE_MUX_FAIL 0xFF
+/**
+ * @def SCREEN_LINES
+ * active display lines
+ */
+#define SCREEN_LINES 192
+/**
+ * @def SPRITE_ATTRIBUTE_TABLE_SIZE
+ * bytes in the sprite attribute table
+ */
+#define SPRITE_ATTRIBUTE_TABLE_SIZE (SPRITE_MAX * 4)
+
+/**
+ * @def SPRITE_GRID_SHIFT
+ * collision grid cells are 32x32 pixels (2^5), the largest sprite size
+ */
+#define SPRITE_GRID_SHIFT 5
+/**
+ * @def SPRITE_GRID_COLS
+ * collision grid columns covering 256 pixels
+ */
+#define SPRITE_GRID_COLS (256 >> SPRITE_GRID_SHIFT)
+/**
+ * @def SPRITE_GRID_ROWS
+ * collision grid rows covering 192 lines
+ */
+#define SPRITE_GRID_ROWS (SCREEN_LINES >> SPRITE_GRID_SHIFT)
+
+/** VRAM LAYOUT DEFINES **/
+/**
+ * @def LAYOUT_NAME
+ * layout table index of the name table
+ */
+#define LAYOUT_NAME 0
+/**
+ * @def LAYOUT_COLOR
+ * layout table index of the color table
+ */
+#define LAYOUT_COLOR 1
+/**
+ * @def LAYOUT_PATTERN
+ * layout table index of the pattern table
+ */
+#define LAYOUT_PATTERN 2
+/**
+ * @def LAYOUT_SPRITE_ATTRIBUTE
+ * layout table index of the sprite attribute table
+ */
+#define LAYOUT_SPRITE_ATTRIBUTE 3
+/**
+ * @def LAYOUT_SPRITE_PATTERN
+ * layout table index of the sprite pattern table
+ */
+#define LAYOUT_SPRITE_PATTERN 4
+/**
+ * @def LAYOUT_TABLES
+ * number of table types in a layout
+ */
+#define LAYOUT_TABLES 5
+/**
+ * @def LAYOUT_MAX_BANKS
+ * most copies of one table type a layout can hold
+ */
+#ifndef LAYOUT_MAX_BANKS
+#define LAYOUT_MAX_BANKS 4
+#endif
+/**
+ * @def LAYOUT_MAX_FREE
+ * most free regions reported by a layout
+ */
+#ifndef LAYOUT_MAX_FREE
+#define LAYOUT_MAX_FREE 8
+#endif
+/**
+ * @def LAYOUT_UNIT_SHIFT
+ * VRAM is tracked in 64 byte units (2^6), the smallest table alignment
+ */
+#define LAYOUT_UNIT_SHIFT 6
+/**
+ * @def LAYOUT_NO_ADDR
+ * address of a table bank that is not used or could not be placed
+ */
+#define LAYOUT_NO_ADDR 0xFFFF
+
+/** PAGE FLIP DEFINES **/
+/**
+ * @def PAGE_SYNC_CHUNK
+ * bytes copied from the front page to the back page per sync step
+ */
+#ifndef PAGE_SYNC_CHUNK
+#define PAGE_SYNC_CHUNK 64
+#endif
+
+/** TILE CACHE DEFINES **/
+/**
+ * @def TILE_CACHE_SLOTS
+ * most pattern slots a tile cache can manage, 4 bytes of RAM each
+ */
+#ifndef TILE_CACHE_SLOTS
+#define TILE_CACHE_SLOTS 64
+#endif
+/**
+ * @def TILE_NONE
+ * tile id of an empty cache slot
+ */
+#define TILE_NONE 0xFFFF
+
+/** VDP GROUP DEFINES **/
+/**
+ * @def GROUP_MAX_CHIPS
+ * most VDPs sharing one data bus in a group
+ */
+#ifndef GROUP_MAX_CHIPS
+#define GROUP_MAX_CHIPS 4
+#endif
+
+/** STEP DEFINES **/
+/**
+ * @def STEP_CHUNK
+ * most bytes moved by one step, also the size of the verify buffer on the stack
+ */
+#ifndef STEP_CHUNK
+#define STEP_CHUNK 128
+#endif
+/**
+ * @def STEP_IDLE
+ * no operation started
+ */
+#define STEP_IDLE 0
+/**
+ * @def STEP_BUSY
+ * operation started, more steps needed
+ */
+#define STEP_BUSY 1
+/**
+ * @def STEP_DONE
+ * operation finished
+ */
+#define STEP_DONE 2
+/**
+ * @def STEP_FAIL
+ * operation finished, vram check failed
+ */
+#define STEP_FAIL 3
+/**
+ * @def STEP_PHASE_WRITE
+ * writing data to vram
+ */
+#define STEP_PHASE_WRITE 0
+/**
+ * @def STEP_PHASE_VERIFY
+ * reading vram back to check it
+ */
+#define STEP_PHASE_VERIFY 1
+/**
+ * @def STEP_CHECK_DATA
+ * pattern written by the vram check
+ */
+#define STEP_CHECK_DATA 0x55
+
+/** VRAM MIRROR DEFINES **/
+/**
+ * @def VRAM_ADDR_MASK
+ * 14 bit vram address
+ */
+#define VRAM_ADDR_MASK 0x3FFF
+/**
+ * @def VRAM_ADDR_SYNC
+ * vdp address matches the tracked address
+ */
+#define VRAM_ADDR_SYNC 0
+/**
+ * @def VRAM_ADDR_LAG
+ * reads were served from RAM, the vdp address needs to be set again
+ */
+#define VRAM_ADDR_LAG 1
+/**
+ * @def VRAM_ADDR_UNKNOWN
+ * a register write or no address set yet, the vdp address is unknown
+ */
+#define VRAM_ADDR_UNKNOWN 2
+
+/** VRAM BLOCK DEFINES **/
+/**
+ * @def VRAM_SRC_RAM
+ * block data is in RAM
+ */
+#define VRAM_SRC_RAM 0
+/**
+ * @def VRAM_SRC_FLASH
+ * block data is in program memory, streamed with table reads
+ */
+#define VRAM_SRC_FLASH 1
+/**
+ * @def VRAM_SRC_CONST
+ * block is one byte repeated, the pointer is to that byte
+ */
+#define VRAM_SRC_CONST 2
+
+/** ANIMATION DEFINES **/
+/**
+ * @def ANIM_MAX_BANKS
+ * most banks of one animated table
+ */
+#ifndef ANIM_MAX_BANKS
+#define ANIM_MAX_BANKS 8
+#endif
+/**
+ * @def ANIM_NO_BANK
+ * bank number returned when a bank could not be added
+ */
+#define ANIM_NO_BANK 0xFF
+
+/** STORE DEFINES **/
+/**
+ * @def STORE_PAGE_SHIFT
+ * store pages are 2^6, 64 bytes, same unit as the layout planner
+ */
+#define STORE_PAGE_SHIFT 6
+/**
+ * @def STORE_PAGE_SIZE
+ * size of a store page in bytes
+ */
+#define STORE_PAGE_SIZE (1 << STORE_PAGE_SHIFT)
+/**
+ * @def STORE_PAGES
+ * number of pages in all of VRAM
+ */
+#define STORE_PAGES (MEM_SIZE >> STORE_PAGE_SHIFT)
+/**
+ * @def STORE_CACHE_PAGES
+ * pages cached in RAM, STORE_PAGE_SIZE + 5 bytes each
+ */
+#ifndef STORE_CACHE_PAGES
+#define STORE_CACHE_PAGES 4
+#endif
+/**
+ * @def STORE_MAX_HANDLES
+ * most buffers allocated at once, 4 bytes of RAM each
+ */
+#ifndef STORE_MAX_HANDLES
+#define STORE_MAX_HANDLES 8
+#endif
+/**
+ * @def STORE_NO_HANDLE
+ * handle returned when a buffer could not be allocated
+ */
+#define STORE_NO_HANDLE 0xFF
+/**
+ * @def STORE_NO_PAGE
+ * address of an empty cache page
+ */
+#define STORE_NO_PAGE 0xFFFF
+
+/** FIFO DEFINES **/
+/**
+ * @def FIFO_STAGE_SIZE
+ * suggested bytes of each RAM stage of a VRAM FIFO, a stage moves in one
+ * blank up to VBLANK_BYTE_LIMIT bytes, bigger stages mean fewer blanks and
+ * address setups per byte
+ */
+#ifndef FIFO_STAGE_SIZE
+#define FIFO_STAGE_SIZE 32
+#endif
+
+/** UPLOAD CACHE DEFINES **/
+/**
+ * @def UPLOAD_CACHE_ENTRIES
+ * most uploads remembered as resident, 6 bytes of RAM each
+ */
+#ifndef UPLOAD_CACHE_ENTRIES
+#define UPLOAD_CACHE_ENTRIES 8
+#endif
+
+/** PROBE DEFINES **/
+/**
+ * @def PROBE_ID_VBLANK
+ * probe event, waiting for the vertical blank
+ */
+#define PROBE_ID_VBLANK 1
+/**
+ * @def PROBE_ID_WRITE
+ * probe event, vram data write
+ */
+#define PROBE_ID_WRITE 2
+/**
+ * @def PROBE_ID_READ
+ * probe event, vram data read
+ */
+#define PROBE_ID_READ 3
+/**
+ * @def PROBE_ID_ADDR
+ * probe event, vram address setup
+ */
+#define PROBE_ID_ADDR 4
+/**
+ * @def PROBE_ID_REG
+ * probe event, register write
+ */
+#define PROBE_ID_REG 5
+#ifdef TMS99XX_PROBE
+/**
+ * @def PROBE_LAT
+ * latch of the probe pins, build with -D TMS99XX_PROBE (make PROBE=1) to
+ * turn the probes on. No default, every test drives some port, pick one it
+ * leaves free (make PROBE=1 PROBE_LAT=LATA). The pins must be set to
+ * outputs by the application.
+ */
+#ifndef PROBE_LAT
+#error "TMS99XX_PROBE needs PROBE_LAT set to a latch the application does not use, ex. make PROBE=1 PROBE_LAT=LATA"
+#endif
+/**
+ * @def PROBE_PIN
+ * pin high for the length of a probed phase
+ */
+#ifndef PROBE_PIN
+#define PROBE_PIN 0
+#endif
+/**
+ * @def PROBE_ID_SHIFT
+ * lowest of the 3 pins holding the event ID for the length of a phase
+ */
+#ifndef PROBE_ID_SHIFT
+#define PROBE_ID_SHIFT 1
+#endif
+/**
+ * @def PROBE_ID_MASK
+ * the 3 event ID pins
+ */
+#define PROBE_ID_MASK (0x07 << PROBE_ID_SHIFT)
+/**
+ * @def PROBE_ISR_PIN
+ * pin high for the length of a register write from an interrupt routine,
+ * its own pin so it can land inside a main level phase
+ */
+#ifndef PROBE_ISR_PIN
+#define PROBE_ISR_PIN 4
+#endif
+/**
+ * @def PROBE_ENTER
+ * probe pin high and the event ID on the ID pins in one latch write, the
+ * ID is settled on the phase edge. A constant ID compiles to a read, and,
+ * or and write. An interrupt in between runs its probe pin high and low
+ * again, so the write does not lose it.
+ */
+#define PROBE_ENTER(id) do { PROBE_LAT = (uint8_t)((PROBE_LAT & (uint8_t)~PROBE_ID_MASK) | (1 << PROBE_PIN) | (((id) & 0x07) << PROBE_ID_SHIFT)); } while(0)
+/**
+ * @def PROBE_EXIT
+ * probe pin and event ID low in one latch write
+ */
+#define PROBE_EXIT() do { PROBE_LAT &= (uint8_t)~((1 << PROBE_PIN) | PROBE_ID_MASK); } while(0)
+/**
+ * @def PROBE_ISR_ENTER
+ * interrupt probe pin high
+ */
+#define PROBE_ISR_ENTER() do { PROBE_LAT |= (1 << PROBE_ISR_PIN); } while(0)
+/**
+ * @def PROBE_ISR_EXIT
+ * interrupt probe pin low
+ */
+#define PROBE_ISR_EXIT() do { PROBE_LAT &= (uint8_t)~(1 << PROBE_ISR_PIN); } while(0)
+#else
+#define PROBE_ENTER(id)
+#define PROBE_EXIT()
+#define PROBE_ISR_ENTER()
+#define PROBE_ISR_EXIT()
+#endif
+
+/** BOOT DEFINES **/
+/**
+ * @def BOOT_CHECK_NONE
+ * boot without a vram check
+ */
+#define BOOT_CHECK_NONE 0
+/**
+ * @def BOOT_CHECK_QUICK
+ * boot with the address and data line check
+ */
+#define BOOT_CHECK_QUICK 1
+/**
+ * @def BOOT_CHECK_FULL
+ * boot with the full 16K vram check
+ */
+#define BOOT_CHECK_FULL 2
+/**
+ * @def BOOT_RLE_RUN
+ * control byte bit for a run, clear for literal bytes
+ */
+#define BOOT_RLE_RUN 0x80
+/**
+ * @def BOOT_RLE_LEN_MASK
+ * control byte bits holding length - 1
+ */
+#define BOOT_RLE_LEN_MASK 0x7F
+
+/** DISPLAY LIST DEFINES **/
+/**
+ * @def LIST_OP_END
+ * end of list
+ */
+#define LIST_OP_END 0x00
+/**
+ * @def LIST_OP_ADDR
+ * set write address, 2 bytes big endian follow
+ */
+#define LIST_OP_ADDR 0x01
+/**
+ * @def LIST_OP_COPY
+ * copy bytes, 2 byte big endian length then the bytes follow
+ */
+#define LIST_OP_COPY 0x02
+/**
+ * @def LIST_OP_FILL
+ * fill, 2 byte big endian length then the value follow
+ */
+#define LIST_OP_FILL 0x03
+/**
+ * @def LIST_OP_REG
+ * set register, register number then value follow
+ */
+#define LIST_OP_REG 0x04
+/**
+ * @def LIST_OP_REPEAT
+ * run till the matching LIST_OP_LOOP count times, count 1 to 255 follows
+ */
+#define LIST_OP_REPEAT 0x05
+/**
+ * @def LIST_OP_LOOP
+ * end of a repeat
+ */
+#define LIST_OP_LOOP 0x06
+/**
+ * @def LIST_OP_VBLANK
+ * wait for the vertical blank
+ */
+#define LIST_OP_VBLANK 0x07
+/**
+ * @def LIST_OP_ASSET
+ * copy a whole asset, asset number follows
+ */
+#define LIST_OP_ASSET 0x08
+/**
+ * @def LIST_MAX_DEPTH
+ * most repeats nested in each other
+ */
+#ifndef LIST_MAX_DEPTH
+#define LIST_MAX_DEPTH 4
+#endif
+/**
+ * @def LIST_END
+ * list entry, end
+ */
+#define LIST_END LIST_OP_END
+/**
+ * @def LIST_ADDR
+ * list entry, set write address
+ */
+#define LIST_ADDR(addr) LIST_OP_ADDR, (uint8_t)(((addr) >> 8) & 0x3F), (uint8_t)((addr) & 0xFF)
+/**
+ * @def LIST_COPY
+ * list entry, copy len bytes, follow it with the bytes
+ */
+#define LIST_COPY(len) LIST_OP_COPY, (uint8_t)((len) >> 8), (uint8_t)((len) & 0xFF)
+/**
+ * @def LIST_FILL
+ * list entry, write value len times
+ */
+#define LIST_FILL(value, len) LIST_OP_FILL, (uint8_t)((len) >> 8), (uint8_t)((len) & 0xFF), (uint8_t)(value)
+/**
+ * @def LIST_REG
+ * list entry, set register
+ */
+#define LIST_REG(num, value) LIST_OP_REG, (uint8_t)(num), (uint8_t)(value)
+/**
+ * @def LIST_REPEAT
+ * list entry, start of a repeat
+ */
+#define LIST_REPEAT(count) LIST_OP_REPEAT, (uint8_t)(count)
+/**
+ * @def LIST_LOOP
+ * list entry, end of a repeat
+ */
+#define LIST_LOOP LIST_OP_LOOP
+/**
+ * @def LIST_VBLANK
+ * list entry, wait for the vertical blank
+ */
+#define LIST_VBLANK LIST_OP_VBLANK
+/**
+ * @def LIST_ASSET
+ * list entry, copy an asset
+ */
+#define LIST_ASSET(num) LIST_OP_ASSET, (uint8_t)(num)
+
+/** WRITE COMBINE DEFINES **/
+/**
+ * @def COMBINE_BUFFER_SIZE
+ * bytes of small writes held for one transfer, 255 at most
+ */
+#ifndef COMBINE_BUFFER_SIZE
+#define COMBINE_BUFFER_SIZE 32
+#endif
+
+/** MODE PROFILE DEFINES **/
+/**
+ * @def PROFILE_MAX_ASSETS
+ * most blocks one profile keeps resident, 8 bytes of RAM each
+ */
+#ifndef PROFILE_MAX_ASSETS
+#define PROFILE_MAX_ASSETS 4
+#endif
+
+/** RASTER DEFINES **/
+/**
+ * @def RASTER_MAX_ENTRIES
+ * most register changes in one frame, 5 bytes of RAM each
+ */
+#ifndef RASTER_MAX_ENTRIES
+#define RASTER_MAX_ENTRIES 8
+#endif
+/**
+ * @def RASTER_LEAD_TICKS
+ * timer ticks an entry is fired early to cover the interrupt entry
+ */
+#ifndef RASTER_LEAD_TICKS
+#define RASTER_LEAD_TICKS 0
+#endif
+
 #endif
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * @file    tms99XXfifo.h
+ * @brief   VRAM ring buffer FIFO for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Byte FIFO held in a free region of VRAM, for buffers too big for PIC
+ *          RAM such as logs or serial receive data. Pushes collect in a RAM
+ *          stage and go to VRAM as one batch, one address setup and the rest of
+ *          the bytes on the auto increment. Pops refill a second RAM stage the
+ *          same way. The caller sizes the stages, a batch moves in one blank
+ *          up to VBLANK_BYTE_LIMIT bytes, so a bigger stage uses more of each
+ *          blank. The ring wraps at the end of the region with one extra
+ *          address setup. Transfers use the library pacing, call from the main
+ *          loop, not an interrupt.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_FIFO
+#define __LIB_TMS99XX_FIFO
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Setup an empty FIFO in a region of VRAM. The region must not hold
+ *          any table. Holds size bytes plus the two RAM stages.
+ * 
+ * @param   p_fifo pointer to struct to contain FIFO data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   vramAddr start of the region.
+ * @param   size size of the region in bytes.
+ * @param   p_pushStage RAM buffer of stageSize bytes for pushed bytes.
+ * @param   p_popStage RAM buffer of stageSize bytes for bytes to pop.
+ * @param   stageSize bytes of each stage, ex. FIFO_STAGE_SIZE.
+ ******************************************************************************/
+void initTMS99XXfifo(struct s_tms99XX_fifo * const p_fifo, struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, uint16_t size, uint8_t *p_pushStage, uint8_t *p_popStage, uint16_t stageSize);
+
+/***************************************************************************//**
+ * @brief   Push bytes. Bytes are staged in RAM, a full stage is written to
+ *          VRAM as one batch.
+ * 
+ * @param   p_fifo pointer to struct to contain FIFO data.
+ * @param   p_data pointer to bytes to push.
+ * @param   size number of bytes to push.
+ * @return  number of bytes pushed, less than size if the FIFO is full.
+ ******************************************************************************/
+uint16_t pushTMS99XXfifo(struct s_tms99XX_fifo * const p_fifo, void const * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Pop bytes, oldest first. An empty RAM stage is refilled from VRAM
+ *          as one batch, or straight from the push stage if VRAM is empty.
+ * 
+ * @param   p_fifo pointer to struct to contain FIFO data.
+ * @param   p_data pointer to store popped bytes.
+ * @param   size most bytes to pop.
+ * @return  number of bytes popped.
+ ******************************************************************************/
+uint16_t popTMS99XXfifo(struct s_tms99XX_fifo * const p_fifo, void * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Write the push stage to VRAM now, ex. from an idle loop so the
+ *          next burst of pushes starts with an empty stage.
+ * 
+ * @param   p_fifo pointer to struct to contain FIFO data.
+ * @return  1 if the stage is empty, 0 if VRAM is full or a transfer timed out.
+ ******************************************************************************/
+uint8_t flushTMS99XXfifo(struct s_tms99XX_fifo * const p_fifo);
+
+/***************************************************************************//**
+ * @brief   Get the number of bytes in the FIFO.
+ * 
+ * @param   p_fifo pointer to struct to contain FIFO data.
+ * @return  number of bytes in both stages and VRAM.
+ ******************************************************************************/
+uint32_t getTMS99XXfifoCount(struct s_tms99XX_fifo const * const p_fifo);
+
+#endif
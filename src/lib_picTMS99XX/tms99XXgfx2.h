@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * @file    tms99XXgfx2.h
+ * @brief   Graphics II bitmap drawing for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details 256x192 bitmap drawing for graphics II mode. The name table
+ *          is laid out so every cell of every third has its own pattern,
+ *          cell n of the screen uses pattern n. Drawing happens on cells
+ *          cached in RAM and nothing is sent to the VDP till a commit, so
+ *          any number of primitives touching a cell cost one upload of
+ *          that cell. Commits are sent in address order so runs of
+ *          neighbouring cells share a single address setup. With shared
+ *          graphics II thirds (setTMS99XXgfx2Thirds) cells of thirds that
+ *          share a table are the same pattern, drawing one draws all. The
+ *          cache is keyed by the table address a cell reads after sharing,
+ *          so those cells share one cached copy.
+ *          Cells load into the cache without a VDP read when they are
+ *          still blank from init or a valid RAM mirror covers them
+ *          (addTMS99XXvramMirror). Only cells drawn, committed and pushed
+ *          out of the cache are read back from VRAM.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_GFX2
+#define __LIB_TMS99XX_GFX2
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Put the VDP in graphics II mode and setup a blank bitmap. Name table
+ *          gets one unique pattern per cell, pattern table is cleared and the
+ *          color table is set to the draw color. This will block till done.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   foreColor 4 bit color of set pixels.
+ * @param   backColor 4 bit color of clear pixels.
+ * @return  1 on success, 0 if a vblank wait timed out.
+ ******************************************************************************/
+uint8_t initTMS99XXgfx2(struct s_tms99XX_gfx2 * const p_gfx2, struct s_tms99XX * const p_tms99XX, uint8_t foreColor, uint8_t backColor);
+
+/***************************************************************************//**
+ * @brief   Set the colors used by the following draw calls. Graphics II has
+ *          one color byte per 8 pixel row of a cell, drawing a pixel sets the
+ *          color of its whole row segment.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @param   foreColor 4 bit color of set pixels.
+ * @param   backColor 4 bit color of clear pixels.
+ ******************************************************************************/
+void setTMS99XXgfx2Color(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t foreColor, uint8_t backColor);
+
+/***************************************************************************//**
+ * @brief   Forget the cached cells and which cells are still blank from
+ *          init, call it after writing the bitmap tables with other calls.
+ *          Uncommitted drawing is lost. Cells then load from a mirror or a
+ *          VRAM read.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ ******************************************************************************/
+void invalidateTMS99XXgfx2(struct s_tms99XX_gfx2 * const p_gfx2);
+
+/***************************************************************************//**
+ * @brief   Set or clear a single pixel.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @param   x horizontal position 0 to 255.
+ * @param   y vertical position 0 to 191.
+ * @param   on 0 clears the pixel, anything else sets it.
+ ******************************************************************************/
+void setTMS99XXgfx2Pixel(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint8_t on);
+
+/***************************************************************************//**
+ * @brief   Draw a horizontal span, a byte at a time where possible.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @param   x left position 0 to 255.
+ * @param   y vertical position 0 to 191.
+ * @param   len number of pixels, clipped at the right edge.
+ ******************************************************************************/
+void drawTMS99XXgfx2HSpan(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint16_t len);
+
+/***************************************************************************//**
+ * @brief   Draw a vertical span.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @param   x horizontal position 0 to 255.
+ * @param   y top position 0 to 191.
+ * @param   len number of pixels, clipped at the bottom edge.
+ ******************************************************************************/
+void drawTMS99XXgfx2VSpan(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint16_t len);
+
+/***************************************************************************//**
+ * @brief   Draw a line between two points (Bresenham). Points off screen
+ *          are clipped per pixel.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @param   x0 start horizontal position.
+ * @param   y0 start vertical position.
+ * @param   x1 end horizontal position.
+ * @param   y1 end vertical position.
+ ******************************************************************************/
+void drawTMS99XXgfx2Line(struct s_tms99XX_gfx2 * const p_gfx2, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+/***************************************************************************//**
+ * @brief   Draw a rectangle outline.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @param   x left position.
+ * @param   y top position.
+ * @param   width width in pixels.
+ * @param   height height in pixels.
+ ******************************************************************************/
+void drawTMS99XXgfx2Rect(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint16_t width, uint16_t height);
+
+/***************************************************************************//**
+ * @brief   Draw a filled rectangle.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @param   x left position.
+ * @param   y top position.
+ * @param   width width in pixels.
+ * @param   height height in pixels.
+ ******************************************************************************/
+void fillTMS99XXgfx2Rect(struct s_tms99XX_gfx2 * const p_gfx2, uint8_t x, uint8_t y, uint16_t width, uint16_t height);
+
+/***************************************************************************//**
+ * @brief   Write all dirty cells to VRAM in address order. Called
+ *          automatically when the cell cache is full, call it once drawing
+ *          for a frame is done. A pixel whose cell could not be read or
+ *          committed when the cache was full is dropped.
+ * 
+ * @param   p_gfx2 pointer to struct to contain bitmap data.
+ * @return  1 on success, 0 if a vblank wait timed out. Cells that did not
+ *          go out stay dirty for the next commit.
+ ******************************************************************************/
+uint8_t commitTMS99XXgfx2(struct s_tms99XX_gfx2 * const p_gfx2);
+
+#endif
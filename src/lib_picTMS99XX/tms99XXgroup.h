@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * @file    tms99XXgroup.h
+ * @brief   Multiple VDP groups for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Several VDPs on one data bus and mode line with their own
+ *          chip selects, ex. an overlay VDP on EXTVID. Pulsing every nCSW
+ *          together writes the same data to all chips in one transfer,
+ *          register setup and fonts cost one transfer instead of one per
+ *          chip. Reads are never broadcast. Per chip access still works
+ *          through each chip's own struct. Resetting the group releases
+ *          every nreset at once so chips on a common clock start their
+ *          frames together, the master's nINT paces all broadcasts.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_GROUP
+#define __LIB_TMS99XX_GROUP
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Start a group with its master chip. The master needs
+ *          initTMS99XXport and initTMS99XX done, its nINT paces broadcasts.
+ *          Broadcasts don't use the master's mirrors, upload cache or
+ *          combine buffer.
+ * 
+ * @param   p_group pointer to struct to contain group data.
+ * @param   p_master pointer to the master TMS99XX struct.
+ ******************************************************************************/
+void initTMS99XXgroup(struct s_tms99XX_group * const p_group, struct s_tms99XX * const p_master);
+
+/***************************************************************************//**
+ * @brief   Add a chip to the group. The chip needs initTMS99XXport done and
+ *          must use the same data and control ports as the master. Its
+ *          registers, tables and vblank timing are set from the master,
+ *          initTMS99XX on the chip is not needed. Mirrors, upload cache and
+ *          combine buffer start detached, attach them after adding.
+ * 
+ * @param   p_group pointer to struct to contain group data.
+ * @param   p_chip pointer to the TMS99XX struct to add.
+ * @return  1 if added, 0 if the group is full or the ports do not match.
+ ******************************************************************************/
+uint8_t addTMS99XXgroupChip(struct s_tms99XX_group * const p_group, struct s_tms99XX * const p_chip);
+
+/***************************************************************************//**
+ * @brief   Reset every chip at once and set them all to the same mode and
+ *          background color with broadcast register writes.
+ * 
+ * @param   p_group pointer to struct to contain group data.
+ * @param   vdpMode set or change the mode, 0 = Graphics I, 1 = Graphics II, 
+ *          2 = bitmap, 4 = Text.
+ * @param   backColor set background color to a 4 bit value.
+ ******************************************************************************/
+void resetTMS99XXgroup(struct s_tms99XX_group * const p_group, uint8_t vdpMode, uint8_t backColor);
+
+/***************************************************************************//**
+ * @brief   Write a register of every chip with one bus transfer. Each chip
+ *          struct is updated to match.
+ * 
+ * @param   p_group pointer to struct to contain group data.
+ * @param   regNum which register to write to. 0 to 7.
+ * @param   regData data to write to register.
+ ******************************************************************************/
+void setTMS99XXgroupReg(struct s_tms99XX_group * const p_group, uint8_t regNum, uint8_t regData);
+
+/***************************************************************************//**
+ * @brief   Write the same data to the same VRAM address of every chip. This
+ *          will block till all data is written. Every chip's combine buffer
+ *          is flushed first, afterwards its mirrors and uploads over the
+ *          range are forgotten.
+ * 
+ * @param   p_group pointer to struct to contain group data.
+ * @param   vramAddr 14 bit address into the vram.
+ * @param   p_data pointer to data to write to the vdps.
+ * @param   size number of bytes to write.
+ * @return  number of bytes written, 0 if a flush or vblank wait timed out.
+ ******************************************************************************/
+int setTMS99XXgroupVramData(struct s_tms99XX_group * const p_group, uint16_t vramAddr, void const * const p_data, int size);
+
+/***************************************************************************//**
+ * @brief   Wait for the master's vertical blank then read the status of
+ *          every chip, clearing all of their interrupts together.
+ * 
+ * @param   p_group pointer to struct to contain group data.
+ ******************************************************************************/
+void waitTMS99XXgroupVblank(struct s_tms99XX_group * const p_group);
+
+#endif
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * @file    tms99XXlayout.h
+ * @brief   VRAM layout planner for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details VRAM layout planner. Given a mode and the tables wanted,
+ *          including extra banks of a table for double buffering or
+ *          animation, places every table on its register alignment
+ *          without overlap and reports the VRAM left free. Graphics II
+ *          pattern and color tables can only sit at 0x0000 or 0x2000,
+ *          shared thirds shrink them and leave the unread thirds free.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_LAYOUT
+#define __LIB_TMS99XX_LAYOUT
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Setup a layout request for a mode. Every table the mode uses gets
+ *          one bank at its full size. Change numBanks or size after this to
+ *          ask for more banks or smaller tables.
+ * 
+ * @param   p_layout pointer to struct to contain layout data.
+ * @param   vdpMode mode to plan for, 0 = Graphics I, 1 = Graphics II, 
+ *          2 = bitmap, 4 = Text.
+ ******************************************************************************/
+void initTMS99XXlayout(struct s_tms99XX_layout * const p_layout, uint8_t vdpMode);
+
+/***************************************************************************//**
+ * @brief   Size the graphics II pattern and color tables for a third
+ *          sharing, see setTMS99XXgfx2Thirds. Thirds no screen third reads
+ *          are left free for other tables.
+ * @param   p_layout pointer to struct to contain layout data.
+ * @param   gfx2Thirds GFX2_THIRDS_FULL, GFX2_THIRDS_SHARED, GFX2_THIRDS_MIXED
+ *          or GFX2_THIRDS_HYBRID.
+ ******************************************************************************/
+void setTMS99XXlayoutThirds(struct s_tms99XX_layout * const p_layout, uint8_t gfx2Thirds);
+
+/***************************************************************************//**
+ * @brief   Place all requested table banks, largest alignment first, each at
+ *          the lowest free aligned address. Then find the free regions.
+ * 
+ * @param   p_layout pointer to struct to contain layout data.
+ * @return  1 if every bank was placed, 0 if VRAM ran out.
+ ******************************************************************************/
+uint8_t planTMS99XXlayout(struct s_tms99XX_layout * const p_layout);
+
+/***************************************************************************//**
+ * @brief   Copy bank 0 of every table into the TMS99XX struct and write the
+ *          mode and table registers.
+ *          The third sharing is copied as well.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_layout pointer to a planned layout.
+ ******************************************************************************/
+void applyTMS99XXlayout(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_layout const * const p_layout);
+
+/***************************************************************************//**
+ * @brief   Get the register alignment of a table in a mode.
+ * 
+ * @param   vdpMode mode of the table.
+ * @param   table LAYOUT_NAME, LAYOUT_COLOR, LAYOUT_PATTERN, 
+ *          LAYOUT_SPRITE_ATTRIBUTE or LAYOUT_SPRITE_PATTERN.
+ * @return  alignment in bytes.
+ ******************************************************************************/
+uint16_t getTMS99XXlayoutAlign(uint8_t vdpMode, uint8_t table);
+
+#endif
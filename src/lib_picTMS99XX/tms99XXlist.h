@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * @file    tms99XXlist.h
+ * @brief   Display list interpreter for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Display lists, screens and effects as data. A list is a short
+ *          bytecode in program memory, set address, copy inline bytes, copy an
+ *          asset, fill, set register, repeat, wait for vblank and end, run by one
+ *          interpreter loop instead of a chain of calls per screen. Copies and
+ *          fills follow each other on the auto increment with no new address
+ *          setup. Each op is still its own paced transfer, with its own di/ei,
+ *          vblank wait and status read, the bus is not held in write mode
+ *          from one op to the next. Lists can be written in C with the LIST_
+ *          macros or compiled from text with tools/tms99XXlistc.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_LIST
+#define __LIB_TMS99XX_LIST
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Run a display list till LIST_OP_END. Register writes keep the
+ *          struct shadow registers and table addresses up to date.
+ * 
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   p_list pointer to const list in program memory.
+ * @param   p_assets pointer to const assets LIST_OP_ASSET copies from, NULL
+ *          if the list has none.
+ * @param   numAssets number of entries in p_assets.
+ * @return  1 at the end of the list, 0 for a bad opcode, asset or loop, or a
+ *          timed out transfer.
+ ******************************************************************************/
+uint8_t runTMS99XXlist(struct s_tms99XX * const p_tms99XX, uint8_t const * const p_list, struct s_tms99XX_asset const * const p_assets, uint8_t numAssets);
+
+#endif
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * @file    tms99XXpage.h
+ * @brief   Page flipping for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Double buffered name and sprite attribute tables. Registers
+ *          2 and 5 can point at any aligned block of VRAM, so showing the
+ *          other page is two register writes at vertical blank instead of
+ *          a copy. The application draws into the back page over as many
+ *          frames as it needs, flips, and can then bring the new back page
+ *          up to date a chunk at a time.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_PAGE
+#define __LIB_TMS99XX_PAGE
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Setup page flipping. Page 0 is the name and sprite attribute table
+ *          currently in the TMS99XX struct and is shown, page 1 is given here.
+ *          Addresses must be aligned to their register scale, see
+ *          tms99XXlayout.h to plan them.
+ * 
+ * @param   p_pageFlip pointer to struct to contain page data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   nameAddr name table address of page 1.
+ * @param   spriteAttributeAddr sprite attribute table address of page 1.
+ ******************************************************************************/
+void initTMS99XXpageFlip(struct s_tms99XX_pageFlip * const p_pageFlip, struct s_tms99XX * const p_tms99XX, uint16_t nameAddr, uint16_t spriteAttributeAddr);
+
+/***************************************************************************//**
+ * @brief   Get the name table address of the back (hidden) page.
+ * 
+ * @param   p_pageFlip pointer to struct to contain page data.
+ * @return  VRAM address to draw the next name table to.
+ ******************************************************************************/
+uint16_t getTMS99XXpageName(struct s_tms99XX_pageFlip * const p_pageFlip);
+
+/***************************************************************************//**
+ * @brief   Get the sprite attribute table address of the back (hidden) page.
+ * 
+ * @param   p_pageFlip pointer to struct to contain page data.
+ * @return  VRAM address to write the next sprite attributes to.
+ ******************************************************************************/
+uint16_t getTMS99XXpageSpriteAttribute(struct s_tms99XX_pageFlip * const p_pageFlip);
+
+/***************************************************************************//**
+ * @brief   Wait for vertical blank and show the back page by writing registers
+ *          2 and 5. The TMS99XX struct addresses follow the shown page. A
+ *          vblank flag or interrupt still pending from before the call is
+ *          cleared first, only a blank that starts after it counts.
+ * 
+ * @param   p_pageFlip pointer to struct to contain page data.
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   sync 0 leaves the new back page as is, anything else marks it to be
+ *          brought up to date by syncTMS99XXpage.
+ * @return  1 if flipped, 0 if the vblank wait timed out, nothing changed.
+ ******************************************************************************/
+uint8_t flipTMS99XXpage(struct s_tms99XX_pageFlip * const p_pageFlip, struct s_tms99XX * const p_tms99XX, uint8_t sync);
+
+/***************************************************************************//**
+ * @brief   Copy one chunk of the shown page to the back page. Call till it
+ *          returns 0, ex. once per frame, to lazily sync the stale page.
+ * 
+ * @param   p_pageFlip pointer to struct to contain page data.
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @return  bytes left to copy.
+ ******************************************************************************/
+uint16_t syncTMS99XXpage(struct s_tms99XX_pageFlip * const p_pageFlip, struct s_tms99XX * const p_tms99XX);
+
+#endif
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * @file    tms99XXprofile.h
+ * @brief   Mode profiles for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Mode profiles, a saved mode with its register set, table layout
+ *          and the blocks it needs in vram (fonts, patterns, colors). Residency is
+ *          kept by the upload cache, so any write over a block is seen. Switching
+ *          to a profile with every block resident is only the register writes,
+ *          else the missing blocks are uploaded with the screen blanked first.
+ *          Give each profile its own tables (see tms99XXlayout) and enough
+ *          UPLOAD_CACHE_ENTRIES for all of their assets.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_PROFILE
+#define __LIB_TMS99XX_PROFILE
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Save the current mode as a profile. Set the mode, layout and
+ *          colors as usual first, the registers are built from the struct.
+ *          The blank and irq bits are not part of a profile, a switch
+ *          keeps them as they are. The profile starts with no assets.
+ * 
+ * @param   p_profile pointer to struct to contain profile data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ ******************************************************************************/
+void initTMS99XXprofile(struct s_tms99XX_profile * const p_profile, struct s_tms99XX const * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Add a block the profile needs in vram. Hashed once here.
+ * 
+ * @param   p_profile pointer to struct to contain profile data.
+ * @param   vramAddr 14 bit address the block goes to.
+ * @param   p_data pointer to const data in program memory.
+ * @param   size number of bytes in the block.
+ * @return  1 on success, 0 if PROFILE_MAX_ASSETS are used.
+ ******************************************************************************/
+uint8_t addTMS99XXprofileAsset(struct s_tms99XX_profile * const p_profile, uint16_t vramAddr, void const * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Switch to a profile. Blocks that are not resident are uploaded
+ *          with the screen blanked and the irq off, then all 8 registers
+ *          and the struct shadow are set from the profile. Needs the upload
+ *          cache attached with setTMS99XXuploadCache, without it every
+ *          switch uploads.
+ * 
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   p_profile pointer to struct containing profile data.
+ * @return  1 on success, 0 if an upload timed out.
+ ******************************************************************************/
+uint8_t setTMS99XXprofile(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_profile * const p_profile);
+
+/***************************************************************************//**
+ * @brief   Check if every block of a profile is resident, no bus access.
+ * 
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   p_profile pointer to struct containing profile data.
+ * @return  1 if a switch would only write registers.
+ ******************************************************************************/
+uint8_t checkTMS99XXprofileResident(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_profile const * const p_profile);
+
+#endif
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * @file    tms99XXraster.h
+ * @brief   Raster effects for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Raster effects, register changes at given scanlines, ex. a backdrop
+ *          color per band or a name table switch for a split screen status bar.
+ *          The VDP has no line interrupt, so the nINT edge stamped by
+ *          isrTMS99XXvblank is the reference and a compare on the same timer
+ *          fires each change, with the frame length from calibrateTMS99XXvblank.
+ *          Changes are register writes only, no vram bandwidth is used.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_RASTER
+#define __LIB_TMS99XX_RASTER
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Setup a raster scheduler with no entries. The compare is a
+ *          compare register pair on the vblank timer set up by the caller
+ *          to raise an interrupt on a match, ex. CCP1 in compare mode
+ *          software interrupt only (CCP1M = 1010) on timer 1. Do not use
+ *          special event trigger, it resets the timer and breaks the
+ *          vblank stamp.
+ * 
+ * @param   p_raster pointer to struct to contain raster data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct with its
+ *          vblank timer calibrated.
+ * @param   p_compareL compare register low byte.
+ * @param   p_compareH compare register high byte.
+ ******************************************************************************/
+void initTMS99XXraster(struct s_tms99XX_raster * const p_raster, struct s_tms99XX * const p_tms99XX, volatile unsigned char *p_compareL, volatile unsigned char *p_compareH);
+
+/***************************************************************************//**
+ * @brief   Set the register changes made each frame. Times are worked out
+ *          here from the calibrated frame period, the interrupts only add
+ *          them to the vblank stamp. Takes effect at the next vblank.
+ *          Values set by a band stay set into the next frame, add an entry
+ *          at scanline 0 that restores them if the top should not keep the
+ *          last band.
+ * 
+ * @param   p_raster pointer to struct to contain raster data.
+ * @param   p_entries changes in scanline order, copied.
+ * @param   numEntries number of changes, 0 stops the scheduler.
+ * @return  1 on success, 0 if the timer is not calibrated, too many
+ *          entries, or they are out of order or past the last line.
+ ******************************************************************************/
+uint8_t setTMS99XXrasterList(struct s_tms99XX_raster * const p_raster, struct s_tms99XX_rasterEntry const * const p_entries, uint8_t numEntries);
+
+/***************************************************************************//**
+ * @brief   Call from the interrupt routine on the nINT falling edge, after
+ *          isrTMS99XXvblank. Arms the compare for the first change.
+ * 
+ * @param   p_raster pointer to struct to contain raster data.
+ ******************************************************************************/
+void isrTMS99XXrasterVblank(struct s_tms99XX_raster * const p_raster);
+
+/***************************************************************************//**
+ * @brief   Call from the interrupt routine on a compare match, the caller
+ *          clears the compare flag. Writes every change that is due, then
+ *          arms the compare for the next one.
+ * 
+ * @param   p_raster pointer to struct to contain raster data.
+ ******************************************************************************/
+void isrTMS99XXrasterCompare(struct s_tms99XX_raster * const p_raster);
+
+#endif
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * @file    tms99XXsprite.h
+ * @brief   Sprite manager for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Sprite manager for the 4 sprites per scanline limit. Each
+ *          frame the sprites per line are counted in software using the
+ *          size and magnify bits of register 1. When any line is over the
+ *          limit the attribute table order is rotated every frame, so the
+ *          dropped sprites change each frame and all of them flicker
+ *          evenly instead of some vanishing. Work per frame is bounded,
+ *          at most 32 sprites of 32 lines each are counted.
+ *          Collisions use the VDP coincidence flag as the trigger and only
+ *          then find the exact pairs.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_SPRITE
+#define __LIB_TMS99XX_SPRITE
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Initialize the sprite manager with the application sprite list.
+ * 
+ * @param   p_spriteMux pointer to struct to contain sprite manager data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   p_sprites array of sprite attributes, owned by the application.
+ * @param   numSprites number of sprites in the array, 0 to 32.
+ ******************************************************************************/
+void initTMS99XXspriteMux(struct s_tms99XX_spriteMux * const p_spriteMux, struct s_tms99XX * const p_tms99XX, union u_tms99XX_spriteAttributeTable * const p_sprites, uint8_t numSprites);
+
+/***************************************************************************//**
+ * @brief   Count sprites per scanline and write the attribute table, rotated
+ *          if any line is over the limit. Call once per frame.
+ * 
+ * @param   p_spriteMux pointer to struct to contain sprite manager data.
+ * @return  most sprites on one scanline, over 4 means sprites are flickering.
+ *          SPRITE_MUX_FAIL if the attribute table write timed out.
+ ******************************************************************************/
+uint8_t updateTMS99XXspriteMux(struct s_tms99XX_spriteMux * const p_spriteMux);
+
+/***************************************************************************//**
+ * @brief   Get the first and last screen line a sprite covers.
+ * 
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   p_sprite sprite attributes to check.
+ * @param   p_top returns the first line, can be negative for sprites partly
+ *          above the screen.
+ * @return  height of the sprite in lines, 0 if it is a terminator.
+ ******************************************************************************/
+uint8_t getTMS99XXspriteLines(struct s_tms99XX * const p_tms99XX, union u_tms99XX_spriteAttributeTable const * const p_sprite, int16_t *p_top);
+
+/***************************************************************************//**
+ * @brief   Find the exact sprite pairs that collided. Only does work when
+ *          the VDP coincidence flag was latched since the last call, then a
+ *          32x32 grid picks candidate pairs and their pattern pixels are
+ *          compared. Only on screen pixels count, same as the VDP.
+ * 
+ * @param   p_spriteMux pointer to struct to contain sprite manager data.
+ * @param   p_patterns sprite pattern table as uploaded to VRAM, 8 bytes per
+ *          name (flash or RAM).
+ * @param   p_pairs array to store colliding pairs in.
+ * @param   maxPairs size of the p_pairs array.
+ * @return  number of pairs stored, 0 if the flag was not set.
+ ******************************************************************************/
+uint8_t checkTMS99XXspriteCollision(struct s_tms99XX_spriteMux * const p_spriteMux, uint8_t const * const p_patterns, struct s_tms99XX_spritePair * const p_pairs, uint8_t maxPairs);
+
+#endif
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * @file    tms99XXstep.h
+ * @brief   Non-blocking VRAM operations for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Step-wise versions of VRAM clear, check, init and large writes.
+ *          Each call to stepTMS99XX moves at most STEP_CHUNK bytes and returns
+ *          the state, all progress is kept in a caller owned context so the main
+ *          loop keeps servicing I/O between slices. Every slice sets its own VRAM
+ *          address, other VDP access between slices is fine. With a vblank
+ *          timeout set by setTMS99XXvblankWait a paced slice never blocks longer
+ *          than the timeout, a timed out slice is simply retried by the next call.
+ *          The default timeout of 0 waits forever, a dead nINT then blocks the
+ *          first paced slice for good. Set one before stepping, VBLANK_IDLE
+ *          timeouts also need initTMS99XXvblankTimer. Checks read over the
+ *          bus, mirrored ranges are not served from RAM.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_STEP
+#define __LIB_TMS99XX_STEP
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Start a step-wise clear of all VRAM to 0x00.
+ * 
+ * @param   p_step pointer to struct to contain step context.
+ * @param   p_tms99XX pointer to struct to contain port data.
+ ******************************************************************************/
+void startTMS99XXstepClear(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Start a step-wise check of all VRAM, same pattern as
+ *          checkTMS99XXvram. Ends in STEP_DONE or STEP_FAIL.
+ * 
+ * @param   p_step pointer to struct to contain step context.
+ * @param   p_tms99XX pointer to struct to contain port data.
+ ******************************************************************************/
+void startTMS99XXstepCheck(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Init the VDP like initTMS99XX, the register setup is done now,
+ *          then VRAM is cleared step-wise. The screen stays blank so the
+ *          clear runs unpaced, enable it after STEP_DONE.
+ * 
+ * @param   p_step pointer to struct to contain step context.
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   vdpMode select the mode of the VDP.
+ * @param   backColor background color.
+ * @param   p_dataPortW data port write.
+ * @param   p_dataPortR data port read.
+ * @param   p_ctrlPortW control port write.
+ * @param   p_intPortR interrupt port read.
+ ******************************************************************************/
+void startTMS99XXstepInit(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX, uint8_t vdpMode, uint8_t backColor, volatile unsigned char *p_dataPortW, volatile unsigned char *p_dataPortR, volatile unsigned char *p_ctrlPortW, volatile unsigned char *p_intPortR);
+
+/***************************************************************************//**
+ * @brief   Start a step-wise write of data to VRAM. The data must stay
+ *          valid till the write is done.
+ * 
+ * @param   p_step pointer to struct to contain step context.
+ * @param   p_tms99XX pointer to struct to contain port data.
+ * @param   vramAddr 14 bit address into the vram to start at.
+ * @param   p_data pointer to data to write.
+ * @param   size number of bytes to write.
+ ******************************************************************************/
+void startTMS99XXstepWrite(struct s_tms99XX_step * const p_step, struct s_tms99XX * const p_tms99XX, uint16_t vramAddr, void const * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Do the next slice of the started operation, at most STEP_CHUNK
+ *          bytes. Blocks at most the vblank timeout of the VDP, forever
+ *          with no timeout and no frames.
+ * 
+ * @param   p_step pointer to struct to contain step context.
+ * @return  STEP_IDLE, STEP_BUSY, STEP_DONE or STEP_FAIL.
+ ******************************************************************************/
+uint8_t stepTMS99XX(struct s_tms99XX_step * const p_step);
+
+/***************************************************************************//**
+ * @brief   Progress of the started operation.
+ * 
+ * @param   p_step pointer to struct to contain step context.
+ * @return  0 to 100 percent done.
+ ******************************************************************************/
+uint8_t getTMS99XXstepProgress(struct s_tms99XX_step * const p_step);
+
+/***************************************************************************//**
+ * @brief   Stop the operation, the context goes back to STEP_IDLE. VRAM
+ *          keeps whatever was already written.
+ * 
+ * @param   p_step pointer to struct to contain step context.
+ ******************************************************************************/
+void abortTMS99XXstep(struct s_tms99XX_step * const p_step);
+
+#endif
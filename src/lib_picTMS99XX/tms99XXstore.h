@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * @file    tms99XXstore.h
+ * @brief   VRAM paged storage for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Paged storage in VRAM the tables do not use. Free regions, ex. the
+ *          free list of a planned layout, are handed to the store and split in
+ *          64 byte pages. Application buffers are allocated from those pages and
+ *          read or written by handle and offset. A few pages are cached in RAM
+ *          so repeated access to the same data does not touch the bus, dirty
+ *          pages go back to VRAM when evicted or flushed.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_STORE
+#define __LIB_TMS99XX_STORE
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Setup an empty store, no free VRAM, no handles, empty cache.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ ******************************************************************************/
+void initTMS99XXstore(struct s_tms99XX_store * const p_store, struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Give a region of VRAM to the store. Only whole pages inside the
+ *          region are used. The region must not hold any table.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ * @param   vramAddr start of the free region.
+ * @param   size size of the free region in bytes.
+ * @return  number of bytes added.
+ ******************************************************************************/
+uint16_t addTMS99XXstoreRegion(struct s_tms99XX_store * const p_store, uint16_t vramAddr, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Allocate a buffer of contiguous pages, first fit.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ * @param   size size of the buffer in bytes.
+ * @return  handle of the buffer, STORE_NO_HANDLE if out of handles or VRAM.
+ ******************************************************************************/
+uint8_t allocTMS99XXstore(struct s_tms99XX_store * const p_store, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Free a buffer. Cached pages of it are dropped without a write.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ * @param   handle handle from allocTMS99XXstore.
+ ******************************************************************************/
+void freeTMS99XXstore(struct s_tms99XX_store * const p_store, uint8_t handle);
+
+/***************************************************************************//**
+ * @brief   Write to a buffer through the page cache. Whole pages written
+ *          are not read from VRAM first.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ * @param   handle handle from allocTMS99XXstore.
+ * @param   offset byte offset in the buffer.
+ * @param   p_data pointer to data to write.
+ * @param   size number of bytes to write, clipped to the buffer.
+ * @return  number of bytes written.
+ ******************************************************************************/
+uint16_t writeTMS99XXstore(struct s_tms99XX_store * const p_store, uint8_t handle, uint16_t offset, void const * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Read from a buffer through the page cache.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ * @param   handle handle from allocTMS99XXstore.
+ * @param   offset byte offset in the buffer.
+ * @param   p_data pointer to store read data.
+ * @param   size number of bytes to read, clipped to the buffer.
+ * @return  number of bytes read.
+ ******************************************************************************/
+uint16_t readTMS99XXstore(struct s_tms99XX_store * const p_store, uint8_t handle, uint16_t offset, void * const p_data, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Write every dirty cached page back to VRAM.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ * @return  1 if all pages were written, 0 if a transfer timed out.
+ ******************************************************************************/
+uint8_t flushTMS99XXstore(struct s_tms99XX_store * const p_store);
+
+/***************************************************************************//**
+ * @brief   Get the free VRAM left in the store.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ * @return  number of free bytes, in whole pages.
+ ******************************************************************************/
+uint16_t getTMS99XXstoreFree(struct s_tms99XX_store const * const p_store);
+
+/***************************************************************************//**
+ * @brief   Clear the hit, miss and write back counters.
+ * 
+ * @param   p_store pointer to struct to contain store data.
+ ******************************************************************************/
+void clearTMS99XXstoreStats(struct s_tms99XX_store * const p_store);
+
+#endif
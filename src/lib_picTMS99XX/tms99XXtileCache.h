@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * @file    tms99XXtileCache.h
+ * @brief   Tile pattern cache for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Least recently used cache of tiles in the pattern table. Maps
+ *          of more than 256 distinct tiles keep all tiles in flash and only
+ *          the ones asked for are uploaded, evicting the tile asked for
+ *          least recently. In graphics I a color table byte is shared by 8
+ *          patterns, a tile can only go in a group of slots with the same
+ *          color. Size the cache above the distinct tiles on screen, the
+ *          hit, miss and eviction counters show how it is doing.
+ * 
+ * @version 0.0.1
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_TILECACHE
+#define __LIB_TMS99XX_TILECACHE
+
+#include <tms99XX.h>
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Setup an empty tile cache over a range of pattern numbers. In
+ *          graphics I the range is rounded in to whole color groups of 8,
+ *          then it is clamped to TILE_CACHE_SLOTS and pattern 255.
+ * 
+ * @param   p_tileCache pointer to struct to contain cache data.
+ * @param   p_tms99XX pointer to an initialized TMS99XX struct.
+ * @param   p_tiles array of all tiles (flash).
+ * @param   numTiles number of tiles in the array.
+ * @param   firstSlot first pattern number the cache may use.
+ * @param   numSlots number of pattern numbers, up to TILE_CACHE_SLOTS.
+ ******************************************************************************/
+void initTMS99XXtileCache(struct s_tms99XX_tileCache * const p_tileCache, struct s_tms99XX * const p_tms99XX, struct s_tms99XX_tile const * const p_tiles, uint16_t numTiles, uint8_t firstSlot, uint8_t numSlots);
+
+/***************************************************************************//**
+ * @brief   Get the pattern number of a tile to write to the name table,
+ *          uploading it if it is not loaded.
+ * 
+ * @param   p_tileCache pointer to struct to contain cache data.
+ * @param   tileId tile number in the tile array.
+ * @return  pattern number holding the tile, TILE_NONE if the tile id is out
+ *          of range or the upload timed out.
+ ******************************************************************************/
+uint16_t getTMS99XXtileCacheName(struct s_tms99XX_tileCache * const p_tileCache, uint16_t tileId);
+
+/***************************************************************************//**
+ * @brief   Clear the hit, miss and eviction counters.
+ * 
+ * @param   p_tileCache pointer to struct to contain cache data.
+ ******************************************************************************/
+void clearTMS99XXtileCacheStats(struct s_tms99XX_tileCache * const p_tileCache);
+
+/***************************************************************************//**
+ * @brief   Forget all loaded tiles, ex. after the pattern table was cleared.
+ * 
+ * @param   p_tileCache pointer to struct to contain cache data.
+ ******************************************************************************/
+void flushTMS99XXtileCache(struct s_tms99XX_tileCache * const p_tileCache);
+
+#endif
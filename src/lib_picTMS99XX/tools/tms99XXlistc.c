@@ -0,0 +1,255 @@
+/*******************************************************************************
+ * @file    tms99XXlistc.c
+ * @brief   Display list compiler for TI TMS9918/28/29 video display processor.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Host side display list compiler. Reads a text list, one command a
+ *          line, and writes a C array for runTMS99XXlist to stdout.
+ *            addr   hex address
+ *            copy   hex bytes or a "string"
+ *            fill   value count
+ *            reg    number value
+ *            repeat count
+ *            loop
+ *            vblank
+ *            asset  number
+ *            end
+ *          Numbers take C prefixes, # starts a comment.
+ *          Build with make tools, run as tools/tms99XXlistc name < list.txt.
+ * 
+ * @license mit
+ * 
+ * Copyright 2022 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+ * copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+
+#include <tms99XXdefines.h>
+
+/**** biggest list in bytes ****/
+#define LISTC_MAX_SIZE 0x4000
+/**** longest line ****/
+#define LISTC_MAX_LINE 512
+
+/** SEE MY PRIVATES **/
+/*** add a byte to the output ***/
+static int addListc(uint8_t data);
+/*** read the next number from the line ***/
+static int getListcNum(char **pp_line, long *p_num);
+/*** compile one copy line, hex bytes or a string ***/
+static int compileListcCopy(char *p_line);
+
+static uint8_t  g_list[LISTC_MAX_SIZE];
+static unsigned g_size = 0;
+
+/*** compile stdin to stdout ***/
+int main(int argc, char *argv[])
+{
+  int depth = 0;
+  unsigned index = 0;
+  unsigned lineNum = 0;
+  long num[2];
+  char line[LISTC_MAX_LINE];
+  char cmd[16];
+  char *p_args = NULL;
+  char *p_comment = NULL;
+  
+  if(argc != 2)
+  {
+    fprintf(stderr, "usage: %s name < list.txt > list.h\n", argv[0]);
+    return 1;
+  }
+  
+  while(fgets(line, sizeof(line), stdin))
+  {
+    lineNum++;
+    
+    /**** strings may hold a #, only cut comments outside of them ****/
+    p_comment = strchr(line, '#');
+    
+    if(p_comment && !memchr(line, '"', (size_t)(p_comment - line))) *p_comment = 0;
+    
+    cmd[0] = 0;
+    
+    if(sscanf(line, "%15s", cmd) != 1) continue;
+    
+    p_args = strstr(line, cmd) + strlen(cmd);
+    
+    if(!strcmp(cmd, "end"))
+    {
+      if(!addListc(LIST_OP_END)) goto error;
+    }
+    else if(!strcmp(cmd, "addr"))
+    {
+      if(!getListcNum(&p_args, &num[0]) || (num[0] < 0) || (num[0] > 0x3FFF)) goto error;
+      
+      if(!addListc(LIST_OP_ADDR) || !addListc((uint8_t)(num[0] >> 8)) || !addListc((uint8_t)num[0])) goto error;
+    }
+    else if(!strcmp(cmd, "copy"))
+    {
+      if(!compileListcCopy(p_args)) goto error;
+    }
+    else if(!strcmp(cmd, "fill"))
+    {
+      if(!getListcNum(&p_args, &num[0]) || !getListcNum(&p_args, &num[1]) || (num[0] < 0) || (num[0] > 0xFF) || (num[1] < 1) || (num[1] > 0x4000)) goto error;
+      
+      if(!addListc(LIST_OP_FILL) || !addListc((uint8_t)(num[1] >> 8)) || !addListc((uint8_t)num[1]) || !addListc((uint8_t)num[0])) goto error;
+    }
+    else if(!strcmp(cmd, "reg"))
+    {
+      if(!getListcNum(&p_args, &num[0]) || !getListcNum(&p_args, &num[1]) || (num[0] < 0) || (num[0] > 7) || (num[1] < 0) || (num[1] > 0xFF)) goto error;
+      
+      if(!addListc(LIST_OP_REG) || !addListc((uint8_t)num[0]) || !addListc((uint8_t)num[1])) goto error;
+    }
+    else if(!strcmp(cmd, "repeat"))
+    {
+      if(!getListcNum(&p_args, &num[0]) || (num[0] < 1) || (num[0] > 255) || (++depth > LIST_MAX_DEPTH)) goto error;
+      
+      if(!addListc(LIST_OP_REPEAT) || !addListc((uint8_t)num[0])) goto error;
+    }
+    else if(!strcmp(cmd, "loop"))
+    {
+      if(--depth < 0) goto error;
+      
+      if(!addListc(LIST_OP_LOOP)) goto error;
+    }
+    else if(!strcmp(cmd, "vblank"))
+    {
+      if(!addListc(LIST_OP_VBLANK)) goto error;
+    }
+    else if(!strcmp(cmd, "asset"))
+    {
+      if(!getListcNum(&p_args, &num[0]) || (num[0] < 0) || (num[0] > 255)) goto error;
+      
+      if(!addListc(LIST_OP_ASSET) || !addListc((uint8_t)num[0])) goto error;
+    }
+    else
+    {
+      goto error;
+    }
+  }
+  
+  if(depth)
+  {
+    fprintf(stderr, "repeat without loop\n");
+    return 1;
+  }
+  
+  /**** lists always stop ****/
+  if(!g_size || (g_list[g_size - 1] != LIST_OP_END)) addListc(LIST_OP_END);
+  
+  printf("const uint8_t %s[] = {", argv[1]);
+  
+  for(index = 0; index < g_size; index++)
+  {
+    printf("%s0x%02X%s", (index % 12) ? "" : "\n  ", g_list[index], (index + 1 < g_size) ? ", " : "");
+  }
+  
+  printf("\n};\n");
+  
+  return 0;
+  
+error:
+  fprintf(stderr, "line %u: bad %s\n", lineNum, cmd);
+  return 1;
+}
+
+/** SEE MY PRIVATES **/
+/*** add a byte to the output ***/
+static int addListc(uint8_t data)
+{
+  if(g_size >= LISTC_MAX_SIZE) return 0;
+  
+  g_list[g_size++] = data;
+  
+  return 1;
+}
+
+/*** read the next number from the line ***/
+static int getListcNum(char **pp_line, long *p_num)
+{
+  char *p_end = NULL;
+  
+  *p_num = strtol(*pp_line, &p_end, 0);
+  
+  if(p_end == *pp_line) return 0;
+  
+  *pp_line = p_end;
+  
+  return 1;
+}
+
+/*** compile one copy line, hex bytes or a string ***/
+static int compileListcCopy(char *p_line)
+{
+  unsigned lenIndex = 0;
+  unsigned len = 0;
+  long num = 0;
+  char *p_end = NULL;
+  
+  if(!addListc(LIST_OP_COPY)) return 0;
+  
+  /**** length is patched once the data is in ****/
+  lenIndex = g_size;
+  
+  if(!addListc(0) || !addListc(0)) return 0;
+  
+  while(isspace((unsigned char)*p_line)) p_line++;
+  
+  if(*p_line == '"')
+  {
+    p_end = strrchr(++p_line, '"');
+    
+    if(!p_end) return 0;
+    
+    for(; p_line < p_end; p_line++, len++)
+    {
+      if(!addListc((uint8_t)*p_line)) return 0;
+    }
+  }
+  else
+  {
+    for(;;)
+    {
+      num = strtol(p_line, &p_end, 16);
+      
+      if(p_end == p_line) break;
+      
+      if((num < 0) || (num > 255) || !addListc((uint8_t)num)) return 0;
+      
+      p_line = p_end;
+      
+      len++;
+    }
+  }
+  
+  if(!len) return 0;
+  
+  g_list[lenIndex] = (uint8_t)(len >> 8);
+  
+  g_list[lenIndex + 1] = (uint8_t)len;
+  
+  return 1;
+}